@@ -0,0 +1,259 @@
+// AABB operations on min/max corners against the center and extent layout
+// they replaced, over arrays of random boxes.
+
+#include <gauge/renderer/aabb.hpp>
+#include <gauge/renderer/frustum.hpp>
+
+#include <benchmark/benchmark.h>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/vector_relational.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace Gauge;
+
+namespace {
+
+namespace Legacy {
+
+struct AABB {
+    Vec3 position{};
+    Vec3 extent{};
+    bool valid = false;
+
+    Vec3 GetMin() const { return position - extent; }
+    Vec3 GetMax() const { return position + extent; }
+
+    void Grow(Vec3 p_point) {
+        if (!valid) {
+            position = p_point;
+            valid = true;
+            return;
+        }
+        for (uint i = 0; i < 3; ++i) {
+            if (p_point[i] > (position[i] + extent[i])) {
+                position[i] = ((position[i] - extent[i]) + p_point[i]) / 2.0;
+                extent[i] = p_point[i] - position[i];
+            } else if (p_point[i] < (position[i] - extent[i])) {
+                position[i] = ((position[i] + extent[i]) + p_point[i]) / 2.0;
+                extent[i] = position[i] - p_point[i];
+            }
+        }
+    }
+
+    bool Overlaps(const AABB& p_other) const {
+        const glm::vec3 distance = glm::abs(glm::vec3(position) - glm::vec3(p_other.position));
+        return glm::all(glm::lessThanEqual(distance, glm::vec3(extent) + glm::vec3(p_other.extent)));
+    }
+
+    bool IntersectsRay(Vec3 p_origin, Vec3 p_inverse_direction, float p_max_distance, float& r_distance) const {
+        const glm::vec3 t0 = (glm::vec3(GetMin()) - glm::vec3(p_origin)) * glm::vec3(p_inverse_direction);
+        const glm::vec3 t1 = (glm::vec3(GetMax()) - glm::vec3(p_origin)) * glm::vec3(p_inverse_direction);
+        const glm::vec3 near = glm::min(t0, t1);
+        const glm::vec3 far = glm::max(t0, t1);
+        const float enter = std::max(std::max(near.x, near.y), std::max(near.z, 0.0f));
+        const float exit = std::min(std::min(far.x, far.y), std::min(far.z, p_max_distance));
+        if (enter > exit) {
+            return false;
+        }
+        r_distance = enter;
+        return true;
+    }
+
+    static AABB FromMinMax(Vec3 p_min, Vec3 p_max) {
+        return AABB{(p_min + p_max) * 0.5f, (p_max - p_min) * 0.5f, true};
+    }
+
+    static AABB Merge(const AABB& p_a, const AABB& p_b) {
+        return FromMinMax(glm::min(glm::vec3(p_a.GetMin()), glm::vec3(p_b.GetMin())), glm::max(glm::vec3(p_a.GetMax()), glm::vec3(p_b.GetMax())));
+    }
+};
+
+Frustum::Result Classify(const Frustum& p_frustum, const AABB& p_aabb) {
+    Frustum::Result result = Frustum::Result::INSIDE;
+    for (const Vec4& plane : p_frustum.planes) {
+        const glm::vec3 normal(plane);
+        const float radius = glm::dot(glm::vec3(p_aabb.extent), glm::abs(normal));
+        const float distance = glm::dot(normal, glm::vec3(p_aabb.position)) + plane.w;
+        if (distance < -radius) {
+            return Frustum::Result::OUTSIDE;
+        }
+        if (distance < radius) {
+            result = Frustum::Result::INTERSECTS;
+        }
+    }
+    return result;
+}
+
+}  // namespace Legacy
+
+constexpr uint BOX_COUNT = 4096;
+
+struct Boxes {
+    std::vector<Gauge::AABB> current;
+    std::vector<Legacy::AABB> legacy;
+};
+
+const Boxes& GetBoxes() {
+    static const Boxes boxes = []() {
+        Boxes boxes;
+        std::mt19937 random(1);
+        std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+        std::uniform_real_distribution<float> extent(0.5f, 5.0f);
+        for (uint i = 0; i < BOX_COUNT; ++i) {
+            const Vec3 center(position(random), position(random), position(random));
+            const Vec3 size(extent(random), extent(random), extent(random));
+            boxes.current.emplace_back(center, size);
+            boxes.legacy.push_back(Legacy::AABB{center, size, true});
+        }
+        return boxes;
+    }();
+    return boxes;
+}
+
+const std::vector<Vec3>& GetPoints() {
+    static const std::vector<Vec3> points = []() {
+        std::mt19937 random(2);
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+        std::vector<Vec3> points;
+        for (uint i = 0; i < BOX_COUNT; ++i) {
+            points.emplace_back(position(random), position(random), position(random));
+        }
+        return points;
+    }();
+    return points;
+}
+
+const Frustum& GetFrustum() {
+    static const Frustum frustum = Frustum::FromMatrix(
+        glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 60.0f) *
+        glm::lookAt(glm::vec3(0.0f, 0.0f, -40.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+    return frustum;
+}
+
+// Bounds of neighbouring pairs, like refitting the levels of a tree
+template <typename Box>
+void Merge(benchmark::State& p_state, const std::vector<Box>& p_boxes) {
+    std::vector<Box> results(p_boxes.size() / 2);
+    for (auto _ : p_state) {
+        for (uint i = 0; i < results.size(); ++i) {
+            results[i] = Box::Merge(p_boxes[2 * i], p_boxes[2 * i + 1]);
+        }
+        benchmark::DoNotOptimize(results.data());
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * results.size());
+}
+
+template <typename Box>
+void GrowPoints(benchmark::State& p_state) {
+    const std::vector<Vec3>& points = GetPoints();
+    for (auto _ : p_state) {
+        Box bounds{};
+        for (const Vec3& point : points) {
+            bounds.Grow(point);
+        }
+        benchmark::DoNotOptimize(bounds);
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * points.size());
+}
+
+template <typename Box, typename F>
+void AllPairs(benchmark::State& p_state, const std::vector<Box>& p_boxes, F&& p_test) {
+    for (auto _ : p_state) {
+        uint hits = 0;
+        for (uint i = 0; i < 64; ++i) {
+            for (const Box& box : p_boxes) {
+                hits += p_test(p_boxes[i], box);
+            }
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * 64 * p_boxes.size());
+}
+
+void MergeCurrent(benchmark::State& p_state) {
+    Merge(p_state, GetBoxes().current);
+}
+
+void MergeLegacy(benchmark::State& p_state) {
+    Merge(p_state, GetBoxes().legacy);
+}
+
+void GrowCurrent(benchmark::State& p_state) {
+    GrowPoints<Gauge::AABB>(p_state);
+}
+
+void GrowLegacy(benchmark::State& p_state) {
+    GrowPoints<Legacy::AABB>(p_state);
+}
+
+void IntersectsCurrent(benchmark::State& p_state) {
+    AllPairs(p_state, GetBoxes().current, [](const Gauge::AABB& a, const Gauge::AABB& b) { return a.Intersects(b); });
+}
+
+void IntersectsLegacy(benchmark::State& p_state) {
+    AllPairs(p_state, GetBoxes().legacy, [](const Legacy::AABB& a, const Legacy::AABB& b) { return a.Overlaps(b); });
+}
+
+template <typename Box>
+void Ray(benchmark::State& p_state, const std::vector<Box>& p_boxes) {
+    const Vec3 origin(-100.0f, 3.0f, -7.0f);
+    const Vec3 inverse_direction = 1.0f / glm::normalize(glm::vec3(1.0f, 0.05f, 0.1f));
+    for (auto _ : p_state) {
+        uint hits = 0;
+        for (const Box& box : p_boxes) {
+            float distance;
+            hits += box.IntersectsRay(origin, inverse_direction, 1000.0f, distance);
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * p_boxes.size());
+}
+
+void RayCurrent(benchmark::State& p_state) {
+    Ray(p_state, GetBoxes().current);
+}
+
+void RayLegacy(benchmark::State& p_state) {
+    Ray(p_state, GetBoxes().legacy);
+}
+
+void ClassifyCurrent(benchmark::State& p_state) {
+    const Frustum& frustum = GetFrustum();
+    for (auto _ : p_state) {
+        uint visible = 0;
+        for (const Gauge::AABB& box : GetBoxes().current) {
+            visible += frustum.Classify(box) != Frustum::Result::OUTSIDE;
+        }
+        benchmark::DoNotOptimize(visible);
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * BOX_COUNT);
+}
+
+void ClassifyLegacy(benchmark::State& p_state) {
+    const Frustum& frustum = GetFrustum();
+    for (auto _ : p_state) {
+        uint visible = 0;
+        for (const Legacy::AABB& box : GetBoxes().legacy) {
+            visible += Legacy::Classify(frustum, box) != Frustum::Result::OUTSIDE;
+        }
+        benchmark::DoNotOptimize(visible);
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * BOX_COUNT);
+}
+
+}  // namespace
+
+BENCHMARK(MergeCurrent);
+BENCHMARK(MergeLegacy);
+BENCHMARK(GrowCurrent);
+BENCHMARK(GrowLegacy);
+BENCHMARK(IntersectsCurrent);
+BENCHMARK(IntersectsLegacy);
+BENCHMARK(RayCurrent);
+BENCHMARK(RayLegacy);
+BENCHMARK(ClassifyCurrent);
+BENCHMARK(ClassifyLegacy);
\ No newline at end of file
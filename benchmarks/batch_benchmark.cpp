@@ -0,0 +1,162 @@
+// Math batch kernels against the per-element code their callers used
+// before: Transform::operator*, Transform::GetMatrix and AABB::Grow. The
+// kernels are SSE by default and AVX2 with GAUGE_AVX2, see GetBatchWidth.
+
+#include <gauge/math/batch.hpp>
+#include <gauge/math/transform.hpp>
+#include <gauge/renderer/aabb.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+using namespace Gauge;
+
+namespace {
+
+std::vector<Transform> MakeTransforms(uint p_count, uint p_seed) {
+    std::mt19937 random(p_seed);
+    std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+    std::vector<Transform> transforms;
+    transforms.reserve(p_count);
+    for (uint i = 0; i < p_count; ++i) {
+        transforms.emplace_back(
+            Vec3(value(random), value(random), value(random)) * 10.0f,
+            glm::normalize(Quaternion(value(random), value(random), value(random), value(random))),
+            1.0f + 0.5f * value(random));
+    }
+    return transforms;
+}
+
+std::vector<AABB> MakeAABBs(uint p_count) {
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+    std::vector<AABB> aabbs;
+    aabbs.reserve(p_count);
+    for (uint i = 0; i < p_count; ++i) {
+        aabbs.emplace_back(Vec3(value(random), value(random), value(random)), Vec3(1.0f));
+    }
+    return aabbs;
+}
+
+std::vector<Vec3> MakePositions(uint p_count) {
+    std::mt19937 random(4);
+    std::uniform_real_distribution<float> value(-100.0f, 100.0f);
+    std::vector<Vec3> positions;
+    positions.reserve(p_count);
+    for (uint i = 0; i < p_count; ++i) {
+        positions.emplace_back(value(random), value(random), value(random));
+    }
+    return positions;
+}
+
+void ComposeBatch(benchmark::State& p_state) {
+    const uint count = p_state.range(0);
+    const std::vector<Transform> parents = MakeTransforms(count, 1);
+    const std::vector<Transform> locals = MakeTransforms(count, 2);
+    std::vector<Transform> results(count);
+    for (auto _ : p_state) {
+        Math::ComposeTransforms(parents, locals, results);
+        benchmark::DoNotOptimize(results.data());
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * count);
+}
+
+void ComposeScalar(benchmark::State& p_state) {
+    const uint count = p_state.range(0);
+    const std::vector<Transform> parents = MakeTransforms(count, 1);
+    const std::vector<Transform> locals = MakeTransforms(count, 2);
+    std::vector<Transform> results(count);
+    for (auto _ : p_state) {
+        for (uint i = 0; i < count; ++i) {
+            results[i] = parents[i] * locals[i];
+        }
+        benchmark::DoNotOptimize(results.data());
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * count);
+}
+
+void MatricesBatch(benchmark::State& p_state) {
+    const uint count = p_state.range(0);
+    const std::vector<Transform> transforms = MakeTransforms(count, 1);
+    std::vector<Mat4> matrices(count);
+    for (auto _ : p_state) {
+        Math::TransformsToMatrices(transforms.data(), count, matrices.data());
+        benchmark::DoNotOptimize(matrices.data());
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * count);
+}
+
+void MatricesScalar(benchmark::State& p_state) {
+    const uint count = p_state.range(0);
+    const std::vector<Transform> transforms = MakeTransforms(count, 1);
+    std::vector<Mat4> matrices(count);
+    for (auto _ : p_state) {
+        for (uint i = 0; i < count; ++i) {
+            matrices[i] = transforms[i].GetMatrix();
+        }
+        benchmark::DoNotOptimize(matrices.data());
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * count);
+}
+
+void AABBsBatch(benchmark::State& p_state) {
+    const uint count = p_state.range(0);
+    const std::vector<Transform> transforms = MakeTransforms(count, 1);
+    const std::vector<AABB> aabbs = MakeAABBs(count);
+    std::vector<AABB> results(count);
+    for (auto _ : p_state) {
+        Math::TransformAABBs(transforms, aabbs, results);
+        benchmark::DoNotOptimize(results.data());
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * count);
+}
+
+void AABBsScalar(benchmark::State& p_state) {
+    const uint count = p_state.range(0);
+    const std::vector<Transform> transforms = MakeTransforms(count, 1);
+    const std::vector<AABB> aabbs = MakeAABBs(count);
+    std::vector<AABB> results(count);
+    for (auto _ : p_state) {
+        for (uint i = 0; i < count; ++i) {
+            results[i] = transforms[i] * aabbs[i];
+        }
+        benchmark::DoNotOptimize(results.data());
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * count);
+}
+
+void BoundsBatch(benchmark::State& p_state) {
+    const uint count = p_state.range(0);
+    const std::vector<Vec3> positions = MakePositions(count);
+    for (auto _ : p_state) {
+        AABB bounds = Math::ComputeBounds(positions.data(), count);
+        benchmark::DoNotOptimize(bounds);
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * count);
+}
+
+void BoundsScalar(benchmark::State& p_state) {
+    const uint count = p_state.range(0);
+    const std::vector<Vec3> positions = MakePositions(count);
+    for (auto _ : p_state) {
+        AABB bounds;
+        for (const Vec3& position : positions) {
+            bounds.Grow(position);
+        }
+        benchmark::DoNotOptimize(bounds);
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * count);
+}
+
+}  // namespace
+
+BENCHMARK(ComposeBatch)->Arg(1024)->Arg(65536);
+BENCHMARK(ComposeScalar)->Arg(1024)->Arg(65536);
+BENCHMARK(MatricesBatch)->Arg(1024)->Arg(65536);
+BENCHMARK(MatricesScalar)->Arg(1024)->Arg(65536);
+BENCHMARK(AABBsBatch)->Arg(1024)->Arg(65536);
+BENCHMARK(AABBsScalar)->Arg(1024)->Arg(65536);
+BENCHMARK(BoundsBatch)->Arg(1024)->Arg(65536);
+BENCHMARK(BoundsScalar)->Arg(1024)->Arg(65536);
\ No newline at end of file
@@ -0,0 +1,223 @@
+// BVH queries against testing every box, with 10k to 1M random boxes at a
+// constant density. Candidates from the tree are tested against their exact
+// bounds like SceneBounds does, so the hits counter of both variants matches.
+
+#include <gauge/renderer/aabb.hpp>
+#include <gauge/renderer/bvh.hpp>
+#include <gauge/renderer/frustum.hpp>
+
+#include <benchmark/benchmark.h>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_transform.hpp>
+
+#include <cmath>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace Gauge;
+
+namespace {
+
+constexpr uint QUERY_COUNT = 64;
+
+struct World {
+    float size;
+    std::vector<AABB> boxes;
+    BVH bvh;
+};
+
+// Built once per object count, 1M inserts are too slow to repeat per run
+const World& GetWorld(uint p_count) {
+    static std::map<uint, std::unique_ptr<World>> worlds;
+    auto& world = worlds[p_count];
+    if (world != nullptr) {
+        return *world;
+    }
+
+    world = std::make_unique<World>();
+    // About one box per 8 cubic units
+    world->size = 2.0f * std::cbrt(float(p_count));
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> position(0.0f, world->size);
+    std::uniform_real_distribution<float> extent(0.25f, 1.0f);
+    world->boxes.reserve(p_count);
+    for (uint i = 0; i < p_count; ++i) {
+        world->boxes.emplace_back(
+            Vec3(position(random), position(random), position(random)),
+            Vec3(extent(random), extent(random), extent(random)));
+        world->bvh.Insert(world->boxes.back(), i);
+    }
+    return *world;
+}
+
+std::vector<AABB> MakeQueryBoxes(const World& p_world) {
+    std::mt19937 random(2);
+    std::uniform_real_distribution<float> position(0.0f, p_world.size);
+    std::vector<AABB> queries;
+    for (uint i = 0; i < QUERY_COUNT; ++i) {
+        queries.emplace_back(Vec3(position(random), position(random), position(random)), Vec3(5.0f));
+    }
+    return queries;
+}
+
+// Cameras in the middle of the world looking along a random direction
+std::vector<Frustum> MakeFrustums(const World& p_world) {
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+    const Vec3 center(p_world.size * 0.5f);
+    const Mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 50.0f);
+    std::vector<Frustum> frustums;
+    for (uint i = 0; i < QUERY_COUNT; ++i) {
+        const Vec3 target = center + Vec3(direction(random), direction(random) * 0.2f, direction(random));
+        frustums.push_back(Frustum::FromMatrix(projection * glm::lookAt(glm::vec3(center), glm::vec3(target), glm::vec3(0.0f, 1.0f, 0.0f))));
+    }
+    return frustums;
+}
+
+struct Ray {
+    Vec3 origin;
+    Vec3 direction;
+};
+
+std::vector<Ray> MakeRays(const World& p_world) {
+    std::mt19937 random(4);
+    std::uniform_real_distribution<float> position(0.0f, p_world.size);
+    std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+    std::vector<Ray> rays;
+    for (uint i = 0; i < QUERY_COUNT; ++i) {
+        const Vec3 origin(position(random), position(random), position(random));
+        rays.push_back(Ray{origin, glm::normalize(glm::vec3(direction(random), direction(random), direction(random)))});
+    }
+    return rays;
+}
+
+void BoxQueryBVH(benchmark::State& p_state) {
+    const World& world = GetWorld(p_state.range(0));
+    const std::vector<AABB> queries = MakeQueryBoxes(world);
+    uint64_t hits = 0;
+    for (auto _ : p_state) {
+        for (const AABB& query : queries) {
+            world.bvh.Query(query, [&](uint p_index) {
+                hits += world.boxes[p_index].Intersects(query);
+            });
+        }
+    }
+    p_state.counters["hits"] = benchmark::Counter(hits, benchmark::Counter::kAvgIterations);
+    p_state.SetItemsProcessed(p_state.iterations() * QUERY_COUNT);
+}
+
+void BoxQueryBruteForce(benchmark::State& p_state) {
+    const World& world = GetWorld(p_state.range(0));
+    const std::vector<AABB> queries = MakeQueryBoxes(world);
+    uint64_t hits = 0;
+    for (auto _ : p_state) {
+        for (const AABB& query : queries) {
+            for (const AABB& box : world.boxes) {
+                hits += box.Intersects(query);
+            }
+        }
+    }
+    p_state.counters["hits"] = benchmark::Counter(hits, benchmark::Counter::kAvgIterations);
+    p_state.SetItemsProcessed(p_state.iterations() * QUERY_COUNT);
+}
+
+void FrustumQueryBVH(benchmark::State& p_state) {
+    const World& world = GetWorld(p_state.range(0));
+    const std::vector<Frustum> frustums = MakeFrustums(world);
+    uint64_t hits = 0;
+    for (auto _ : p_state) {
+        for (const Frustum& frustum : frustums) {
+            world.bvh.QueryFrustum(frustum, [&](uint p_index) {
+                hits += frustum.IsVisible(world.boxes[p_index]);
+            });
+        }
+    }
+    p_state.counters["hits"] = benchmark::Counter(hits, benchmark::Counter::kAvgIterations);
+    p_state.SetItemsProcessed(p_state.iterations() * QUERY_COUNT);
+}
+
+void FrustumQueryBruteForce(benchmark::State& p_state) {
+    const World& world = GetWorld(p_state.range(0));
+    const std::vector<Frustum> frustums = MakeFrustums(world);
+    uint64_t hits = 0;
+    for (auto _ : p_state) {
+        for (const Frustum& frustum : frustums) {
+            for (const AABB& box : world.boxes) {
+                hits += frustum.IsVisible(box);
+            }
+        }
+    }
+    p_state.counters["hits"] = benchmark::Counter(hits, benchmark::Counter::kAvgIterations);
+    p_state.SetItemsProcessed(p_state.iterations() * QUERY_COUNT);
+}
+
+// Closest hit, like SceneBounds::Raycast
+void RaycastBVH(benchmark::State& p_state) {
+    const World& world = GetWorld(p_state.range(0));
+    const std::vector<Ray> rays = MakeRays(world);
+    uint64_t hits = 0;
+    for (auto _ : p_state) {
+        for (const Ray& ray : rays) {
+            const Vec3 inverse_direction = 1.0f / glm::vec3(ray.direction);
+            bool hit = false;
+            world.bvh.Raycast(ray.origin, ray.direction, world.size, [&](uint p_index, float p_max_distance) {
+                float distance;
+                if (world.boxes[p_index].IntersectsRay(ray.origin, inverse_direction, p_max_distance, distance)) {
+                    hit = true;
+                    return distance;
+                }
+                return p_max_distance;
+            });
+            hits += hit;
+        }
+    }
+    p_state.counters["hits"] = benchmark::Counter(hits, benchmark::Counter::kAvgIterations);
+    p_state.SetItemsProcessed(p_state.iterations() * QUERY_COUNT);
+}
+
+void RaycastBruteForce(benchmark::State& p_state) {
+    const World& world = GetWorld(p_state.range(0));
+    const std::vector<Ray> rays = MakeRays(world);
+    uint64_t hits = 0;
+    for (auto _ : p_state) {
+        for (const Ray& ray : rays) {
+            const Vec3 inverse_direction = 1.0f / glm::vec3(ray.direction);
+            float max_distance = world.size;
+            bool hit = false;
+            for (const AABB& box : world.boxes) {
+                float distance;
+                if (box.IntersectsRay(ray.origin, inverse_direction, max_distance, distance)) {
+                    max_distance = distance;
+                    hit = true;
+                }
+            }
+            hits += hit;
+        }
+    }
+    p_state.counters["hits"] = benchmark::Counter(hits, benchmark::Counter::kAvgIterations);
+    p_state.SetItemsProcessed(p_state.iterations() * QUERY_COUNT);
+}
+
+void Build(benchmark::State& p_state) {
+    const World& world = GetWorld(p_state.range(0));
+    for (auto _ : p_state) {
+        BVH bvh;
+        for (uint i = 0; i < world.boxes.size(); ++i) {
+            bvh.Insert(world.boxes[i], i);
+        }
+        benchmark::DoNotOptimize(bvh.GetHeight());
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * world.boxes.size());
+}
+
+}  // namespace
+
+BENCHMARK(BoxQueryBVH)->RangeMultiplier(10)->Range(10000, 1000000);
+BENCHMARK(BoxQueryBruteForce)->RangeMultiplier(10)->Range(10000, 1000000);
+BENCHMARK(FrustumQueryBVH)->RangeMultiplier(10)->Range(10000, 1000000);
+BENCHMARK(FrustumQueryBruteForce)->RangeMultiplier(10)->Range(10000, 1000000);
+BENCHMARK(RaycastBVH)->RangeMultiplier(10)->Range(10000, 1000000);
+BENCHMARK(RaycastBruteForce)->RangeMultiplier(10)->Range(10000, 1000000);
+BENCHMARK(Build)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
\ No newline at end of file
@@ -0,0 +1,128 @@
+// Update and draw traversal of one component per node over a 10k node tree.
+// The tree walk over heap allocated components is the layout every type used
+// before ComponentStorage, and still the one of types that don't opt in.
+
+#include <gauge/components/component.hpp>
+#include <gauge/components/component_storage.hpp>
+#include <gauge/scene/node.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <format>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace Gauge;
+
+namespace {
+
+constexpr uint NODE_COUNT = 10000;
+constexpr uint BRANCHING = 4;
+
+uint64_t draw_count = 0;
+
+struct HeapComponent final : public Component {
+    float angle = 0.0f;
+
+    virtual void Update(float delta) override { angle += delta; }
+    virtual void Draw() override { draw_count++; }
+    virtual uint GetUpdateAccess() const override { return UpdateAccess::NONE; }
+
+    static void StaticInitialize() {}
+};
+
+struct StoredComponent final : public Component {
+    float angle = 0.0f;
+
+    virtual void Update(float delta) override { angle += delta; }
+    virtual void Draw() override { draw_count++; }
+    virtual uint GetUpdateAccess() const override { return UpdateAccess::NONE; }
+
+    static void StaticInitialize() {}
+    static constexpr bool CONTIGUOUS_STORAGE = true;
+};
+
+// Components are added in random order, as they are when scenes are loaded
+// and edited over time
+template <typename C>
+std::vector<Ref<Node>> MakeTree() {
+    std::vector<Ref<Node>> nodes(NODE_COUNT);
+    Node::CreateBatch(nodes);
+    for (uint i = 0; i < NODE_COUNT; ++i) {
+        nodes[i]->name = StringID(std::format("bench_node_{}", i));
+        if (i > 0) {
+            nodes[(i - 1) / BRANCHING]->AddChild(nodes[i]);
+        }
+    }
+
+    std::vector<uint> order(NODE_COUNT);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(1));
+    for (const uint i : order) {
+        nodes[i]->AddComponent<C>();
+    }
+    return nodes;
+}
+
+// Node::Update before the UpdateScheduler
+void LegacyUpdate(Node& p_node, float p_delta) {
+    if (!p_node.active) {
+        return;
+    }
+    for (const auto& component : p_node.GetComponents()) {
+        if (component->active) {
+            component->Update(p_delta);
+        }
+    }
+    for (const auto& child : p_node.children) {
+        LegacyUpdate(*child, p_delta);
+    }
+}
+
+void UpdateTree(benchmark::State& p_state) {
+    const std::vector<Ref<Node>> nodes = MakeTree<HeapComponent>();
+    for (auto _ : p_state) {
+        LegacyUpdate(*nodes[0], 0.016f);
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * NODE_COUNT);
+}
+
+void UpdateStorage(benchmark::State& p_state) {
+    const std::vector<Ref<Node>> nodes = MakeTree<StoredComponent>();
+    for (auto _ : p_state) {
+        ComponentStorage<StoredComponent>::Get().ForEach([](StoredComponent& p_component) {
+            if (p_component.active) {
+                p_component.Update(0.016f);
+            }
+        });
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * NODE_COUNT);
+}
+
+void DrawTree(benchmark::State& p_state) {
+    const std::vector<Ref<Node>> nodes = MakeTree<HeapComponent>();
+    for (auto _ : p_state) {
+        nodes[0]->Draw();
+    }
+    benchmark::DoNotOptimize(draw_count);
+    p_state.SetItemsProcessed(p_state.iterations() * NODE_COUNT);
+}
+
+// What SceneTree::Draw does for stored types, including the visibility walk
+void DrawStorage(benchmark::State& p_state) {
+    const std::vector<Ref<Node>> nodes = MakeTree<StoredComponent>();
+    for (auto _ : p_state) {
+        ComponentStorage<StoredComponent>::Get().Draw(*nodes[0]);
+    }
+    benchmark::DoNotOptimize(draw_count);
+    p_state.SetItemsProcessed(p_state.iterations() * NODE_COUNT);
+}
+
+}  // namespace
+
+BENCHMARK(UpdateTree);
+BENCHMARK(UpdateStorage);
+BENCHMARK(DrawTree);
+BENCHMARK(DrawStorage);
\ No newline at end of file
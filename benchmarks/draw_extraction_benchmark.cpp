@@ -0,0 +1,173 @@
+// Extracting 100k mesh surfaces into draw lists, as MeshInstance::Draw does
+// every frame. The legacy path is the one before typed draw queues: every
+// surface turned its shader id into a string, compared it against the shader
+// names and looked the shader up by type_index, copying a shared_ptr.
+
+#include <gauge/core/frame_arena.hpp>
+#include <gauge/core/string_id.hpp>
+#include <gauge/renderer/shaders/mesh_shader.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+using namespace Gauge;
+
+namespace {
+
+constexpr uint INSTANCE_COUNT = 25000;
+constexpr uint SURFACES_PER_INSTANCE = 4;
+
+using DrawObject = MeshShader::DrawObject;
+
+namespace Legacy {
+
+struct Surface {
+    Handle<GPUMesh> primitive;
+    Handle<GPUMaterial> material;
+    StringID shader_id;
+};
+
+struct Shader {
+    std::vector<DrawObject> objects;
+    virtual ~Shader() {}
+};
+
+struct PBRShader : Shader {};
+struct GizmoShader : Shader {};
+
+struct RendererBase {
+    virtual ~RendererBase() {}
+};
+
+struct Renderer : RendererBase {
+    std::unordered_map<std::type_index, Ref<Shader>> shaders;
+
+    template <typename S>
+    Ref<S> GetShader() {
+        return std::static_pointer_cast<S>(shaders[std::type_index(typeid(S))]);
+    }
+};
+
+}  // namespace Legacy
+
+struct Surface {
+    Handle<GPUMesh> primitive;
+    Handle<GPUMaterial> material;
+    uint draw_queue;
+};
+
+// One in ten surfaces is a gizmo, the rest PBR
+bool IsGizmo(uint p_instance, uint p_surface) {
+    return (p_instance * SURFACES_PER_INSTANCE + p_surface) % 10 == 0;
+}
+
+std::vector<Transform> MakeTransforms() {
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::vector<Transform> transforms;
+    transforms.reserve(INSTANCE_COUNT);
+    for (uint i = 0; i < INSTANCE_COUNT; ++i) {
+        transforms.emplace_back(Vec3(position(random), position(random), position(random)), Quaternion(1.0f, 0.0f, 0.0f, 0.0f), 1.0f);
+    }
+    return transforms;
+}
+
+void ExtractLegacy(benchmark::State& p_state) {
+    const std::vector<Transform> transforms = MakeTransforms();
+    std::vector<std::vector<Legacy::Surface>> instances(INSTANCE_COUNT);
+    for (uint i = 0; i < INSTANCE_COUNT; ++i) {
+        for (uint s = 0; s < SURFACES_PER_INSTANCE; ++s) {
+            instances[i].push_back(Legacy::Surface{
+                .primitive = {.index = i},
+                .material = {.index = s},
+                .shader_id = IsGizmo(i, s) ? StringID("Gizmo") : StringID("PBR"),
+            });
+        }
+    }
+
+    Legacy::Renderer legacy_renderer;
+    legacy_renderer.shaders[std::type_index(typeid(Legacy::PBRShader))] = std::make_shared<Legacy::PBRShader>();
+    legacy_renderer.shaders[std::type_index(typeid(Legacy::GizmoShader))] = std::make_shared<Legacy::GizmoShader>();
+    std::unique_ptr<Legacy::RendererBase> renderer_base = std::make_unique<Legacy::Renderer>(std::move(legacy_renderer));
+    benchmark::DoNotOptimize(renderer_base.get());
+
+    for (auto _ : p_state) {
+        for (const auto& [type, shader] : static_cast<Legacy::Renderer&>(*renderer_base).shaders) {
+            shader->objects.clear();
+        }
+        for (uint i = 0; i < INSTANCE_COUNT; ++i) {
+            for (const Legacy::Surface& surface : instances[i]) {
+                auto renderer = static_cast<Legacy::Renderer*>(renderer_base.get());
+                auto shader_name = std::string(surface.shader_id);
+                if (shader_name == "PBR") {
+                    renderer->GetShader<Legacy::PBRShader>()->objects.emplace_back(DrawObject{
+                        .primitive = surface.primitive,
+                        .material = surface.material,
+                        .transform = transforms[i],
+                        .node_handle = i,
+                    });
+                } else if (shader_name == "Gizmo") {
+                    renderer->GetShader<Legacy::GizmoShader>()->objects.emplace_back(DrawObject{
+                        .primitive = surface.primitive,
+                        .material = surface.material,
+                        .transform = transforms[i],
+                        .node_handle = i,
+                    });
+                }
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * INSTANCE_COUNT * SURFACES_PER_INSTANCE);
+}
+
+// Queues are resolved once per surface and rebound to the frame arena every
+// frame, like RendererVulkan::SubmitMesh
+void ExtractQueues(benchmark::State& p_state) {
+    const std::vector<Transform> transforms = MakeTransforms();
+    std::vector<std::vector<Surface>> instances(INSTANCE_COUNT);
+    for (uint i = 0; i < INSTANCE_COUNT; ++i) {
+        for (uint s = 0; s < SURFACES_PER_INSTANCE; ++s) {
+            instances[i].push_back(Surface{
+                .primitive = {.index = i},
+                .material = {.index = s},
+                .draw_queue = IsGizmo(i, s) ? 1u : 0u,
+            });
+        }
+    }
+
+    FrameArena arena;
+    std::vector<ArenaVector<DrawObject>> queues(2);
+    for (auto _ : p_state) {
+        arena.Reset();
+        for (ArenaVector<DrawObject>& queue : queues) {
+            queue = ArenaVector<DrawObject>(arena);
+        }
+        for (uint i = 0; i < INSTANCE_COUNT; ++i) {
+            const Transform& transform = transforms[i];
+            for (const Surface& surface : instances[i]) {
+                if (surface.draw_queue != ~0u) {
+                    queues[surface.draw_queue].push_back(DrawObject{
+                        .primitive = surface.primitive,
+                        .material = surface.material,
+                        .transform = transform,
+                        .node_handle = i,
+                    });
+                }
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * INSTANCE_COUNT * SURFACES_PER_INSTANCE);
+}
+
+}  // namespace
+
+BENCHMARK(ExtractLegacy)->Unit(benchmark::kMicrosecond);
+BENCHMARK(ExtractQueues)->Unit(benchmark::kMicrosecond);
\ No newline at end of file
@@ -0,0 +1,120 @@
+// Building draw keys and sorting draws by them, as WriteDrawObjects does for
+// every viewport. RadixSort is compared against std::sort and
+// std::stable_sort over the same key and index pairs.
+
+#include <gauge/core/radix_sort.hpp>
+#include <gauge/renderer/draw_key.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace Gauge;
+
+namespace {
+
+struct Object {
+    uint pass;
+    uint queue;
+    uint material;
+    uint mesh;
+    float depth;
+};
+
+// Mostly opaque objects over a few hundred materials and meshes, like a
+// scene built from a handful of glTF files
+std::vector<Object> MakeObjects(uint p_count) {
+    std::mt19937 random(1);
+    std::uniform_int_distribution<uint> material(0, 255);
+    std::uniform_int_distribution<uint> mesh(0, 511);
+    std::uniform_real_distribution<float> depth(0.1f, 500.0f);
+    std::uniform_int_distribution<uint> percent(0, 99);
+    std::vector<Object> objects(p_count);
+    for (Object& object : objects) {
+        const uint roll = percent(random);
+        object.pass = roll < 90 ? 0 : (roll < 98 ? 1 : 2);
+        object.queue = object.pass == 2 ? 2 : object.pass;
+        object.material = material(random);
+        object.mesh = mesh(random);
+        object.depth = depth(random);
+    }
+    return objects;
+}
+
+std::vector<uint64_t> BuildKeys(const std::vector<Object>& p_objects) {
+    std::vector<uint64_t> keys(p_objects.size());
+    for (uint i = 0; i < p_objects.size(); ++i) {
+        const Object& object = p_objects[i];
+        keys[i] = object.pass == 0
+                      ? DrawKey::Opaque(object.pass, object.queue, object.material, object.mesh, object.depth)
+                      : DrawKey::Blended(object.pass, object.queue, object.material, object.mesh, object.depth);
+    }
+    return keys;
+}
+
+void BuildDrawKeys(benchmark::State& p_state) {
+    const std::vector<Object> objects = MakeObjects(p_state.range(0));
+    std::vector<uint64_t> keys(objects.size());
+    for (auto _ : p_state) {
+        for (uint i = 0; i < objects.size(); ++i) {
+            const Object& object = objects[i];
+            keys[i] = object.pass == 0
+                          ? DrawKey::Opaque(object.pass, object.queue, object.material, object.mesh, object.depth)
+                          : DrawKey::Blended(object.pass, object.queue, object.material, object.mesh, object.depth);
+        }
+        benchmark::DoNotOptimize(keys.data());
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * objects.size());
+}
+
+void SortRadix(benchmark::State& p_state) {
+    const std::vector<uint64_t> source = BuildKeys(MakeObjects(p_state.range(0)));
+    const size_t count = source.size();
+    std::vector<uint64_t> keys(count), scratch_keys(count);
+    std::vector<uint> order(count), scratch_order(count);
+    for (auto _ : p_state) {
+        std::copy(source.begin(), source.end(), keys.begin());
+        std::iota(order.begin(), order.end(), 0);
+        RadixSort<uint>(keys, order, scratch_keys, scratch_order);
+        benchmark::DoNotOptimize(order.data());
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * count);
+}
+
+void SortStd(benchmark::State& p_state) {
+    const std::vector<uint64_t> source = BuildKeys(MakeObjects(p_state.range(0)));
+    const size_t count = source.size();
+    std::vector<std::pair<uint64_t, uint>> pairs(count);
+    for (auto _ : p_state) {
+        for (uint i = 0; i < count; ++i) {
+            pairs[i] = {source[i], i};
+        }
+        std::sort(pairs.begin(), pairs.end());
+        benchmark::DoNotOptimize(pairs.data());
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * count);
+}
+
+// Stable like RadixSort, objects with equal keys keep their submission order
+void SortStdStable(benchmark::State& p_state) {
+    const std::vector<uint64_t> source = BuildKeys(MakeObjects(p_state.range(0)));
+    const size_t count = source.size();
+    std::vector<uint> order(count);
+    for (auto _ : p_state) {
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](uint a, uint b) { return source[a] < source[b]; });
+        benchmark::DoNotOptimize(order.data());
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * count);
+}
+
+}  // namespace
+
+BENCHMARK(BuildDrawKeys)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK(SortRadix)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK(SortStd)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK(SortStdStable)->RangeMultiplier(10)->Range(1000, 100000);
\ No newline at end of file
@@ -0,0 +1,148 @@
+// Allocate, get and free throughput of Pool against the Pool it replaced,
+// which stored 16 bit handles in one resizable vector with a queue as its
+// free list.
+
+#include <gauge/core/pool.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace Gauge;
+
+namespace {
+
+namespace Legacy {
+
+template <typename T>
+struct Handle {
+    uint16_t index{};
+    uint16_t generation{};
+};
+
+template <typename T>
+struct Pool {
+    std::vector<T> data;
+    std::vector<uint16_t> generations;
+    std::queue<uint16_t> free_list;
+
+    Handle<T> Allocate(T p_data) {
+        if (free_list.empty()) [[unlikely]] {
+            uint new_size = 2 * data.size();
+            data.resize(new_size);
+            generations.resize(new_size);
+            for (uint i = new_size - 1; i >= (new_size / 2); --i) {
+                free_list.push(i);
+            }
+        }
+        uint16_t index = free_list.front();
+        data[index] = p_data;
+        free_list.pop();
+        return {
+            .index = index,
+            .generation = generations[index],
+        };
+    }
+
+    T* Get(Handle<T> p_handle) {
+        if (p_handle.generation != generations[p_handle.index]) {
+            return nullptr;
+        }
+        return &data[p_handle.index];
+    }
+
+    void Free(Handle<T> p_handle) {
+        generations[p_handle.index]++;
+        free_list.push(p_handle.index);
+    }
+
+    Pool(uint p_initial_size = 2048) {
+        data.resize(p_initial_size);
+        generations.resize(p_initial_size);
+        for (uint i = 0; i < p_initial_size - 1; ++i) {
+            free_list.push(i);
+        }
+    }
+};
+
+}  // namespace Legacy
+
+// Roughly the size of a transform or a small component
+using Item = std::array<float, 16>;
+// Legacy handles can't address more than 65 536 slots
+constexpr uint ITEM_COUNT = 50000;
+
+template <typename P>
+using HandleOf = decltype(std::declval<P&>().Allocate(Item{}));
+
+template <typename P>
+void AllocateFree(benchmark::State& p_state) {
+    P pool;
+    std::vector<HandleOf<P>> handles(ITEM_COUNT);
+    for (auto _ : p_state) {
+        for (uint i = 0; i < ITEM_COUNT; ++i) {
+            handles[i] = pool.Allocate(Item{float(i)});
+        }
+        for (uint i = 0; i < ITEM_COUNT; ++i) {
+            pool.Free(handles[i]);
+        }
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * ITEM_COUNT);
+}
+
+template <typename P>
+void Get(benchmark::State& p_state) {
+    P pool;
+    std::vector<HandleOf<P>> handles;
+    handles.reserve(ITEM_COUNT);
+    for (uint i = 0; i < ITEM_COUNT; ++i) {
+        handles.push_back(pool.Allocate(Item{float(i)}));
+    }
+    std::shuffle(handles.begin(), handles.end(), std::mt19937(1));
+
+    for (auto _ : p_state) {
+        float sum = 0.0f;
+        for (const auto& handle : handles) {
+            sum += (*pool.Get(handle))[0];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * ITEM_COUNT);
+}
+
+// Frees and reallocates a random tenth of a full pool per iteration, the
+// pattern of nodes and meshes being streamed in and out
+template <typename P>
+void Churn(benchmark::State& p_state) {
+    P pool;
+    std::vector<HandleOf<P>> handles;
+    handles.reserve(ITEM_COUNT);
+    for (uint i = 0; i < ITEM_COUNT; ++i) {
+        handles.push_back(pool.Allocate(Item{float(i)}));
+    }
+    std::mt19937 random(1);
+    std::uniform_int_distribution<uint> pick(0, ITEM_COUNT - 1);
+
+    for (auto _ : p_state) {
+        for (uint i = 0; i < ITEM_COUNT / 10; ++i) {
+            HandleOf<P>& handle = handles[pick(random)];
+            pool.Free(handle);
+            handle = pool.Allocate(Item{float(i)});
+        }
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * (ITEM_COUNT / 10));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(AllocateFree, Pool<Item>);
+BENCHMARK_TEMPLATE(AllocateFree, Legacy::Pool<Item>);
+BENCHMARK_TEMPLATE(Get, Pool<Item>);
+BENCHMARK_TEMPLATE(Get, Legacy::Pool<Item>);
+BENCHMARK_TEMPLATE(Churn, Pool<Item>);
+BENCHMARK_TEMPLATE(Churn, Legacy::Pool<Item>);
\ No newline at end of file
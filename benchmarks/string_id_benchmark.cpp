@@ -0,0 +1,64 @@
+// Interning StringIDs from 1..N threads at once, the way asset loaders and
+// physics jobs create them.
+
+#include <gauge/core/string_id.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <format>
+#include <string>
+#include <vector>
+
+using namespace Gauge;
+
+namespace {
+
+constexpr uint NAME_COUNT = 4096;
+
+const std::vector<std::string>& GetNames() {
+    static const std::vector<std::string> names = []() {
+        std::vector<std::string> names;
+        for (uint i = 0; i < NAME_COUNT; ++i) {
+            names.push_back(std::format("assets/models/prop_{}.gltf", i));
+        }
+        return names;
+    }();
+    return names;
+}
+
+// Names that are already in the table, the common case of resolving paths
+// and node names that were seen before
+void InternExisting(benchmark::State& p_state) {
+    const std::vector<std::string>& names = GetNames();
+    if (p_state.thread_index() == 0) {
+        for (const std::string& name : names) {
+            StringID{name};
+        }
+    }
+    uint i = p_state.thread_index() * 131;
+    for (auto _ : p_state) {
+        const StringID id(names[i++ % NAME_COUNT]);
+        benchmark::DoNotOptimize(id.GetString().size());
+    }
+    p_state.SetItemsProcessed(p_state.iterations());
+}
+
+// Names no thread interned before, every iteration inserts
+void InternNew(benchmark::State& p_state) {
+    static std::atomic<uint> run = 0;
+    const uint prefix = run++;
+    std::string name;
+    uint64_t i = 0;
+    for (auto _ : p_state) {
+        name = std::format("run{}/thread{}/{}", prefix, p_state.thread_index(), i++);
+        const StringID id(name);
+        benchmark::DoNotOptimize(id.id);
+    }
+    p_state.SetItemsProcessed(p_state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(InternExisting)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(InternNew)->ThreadRange(1, 32)->UseRealTime();
\ No newline at end of file
@@ -0,0 +1,142 @@
+// Per-frame transform cost of a 100k node hierarchy where a fraction of the
+// nodes move every frame. TransformHierarchy is compared against the node
+// tree it replaced, where every setter refreshed its subtree and the
+// renderer refreshed the whole tree once per viewport.
+
+#include <gauge/math/transform.hpp>
+#include <gauge/scene/transform_hierarchy.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace Gauge;
+
+namespace {
+
+namespace Legacy {
+
+struct Node {
+    Transform local_transform;
+    Transform global_transform;
+    std::vector<std::shared_ptr<Node>> children;
+    std::weak_ptr<Node> parent;
+
+    void RefreshTransform() {
+        if (auto parent_node = parent.lock()) {
+            RefreshTransform(parent_node->global_transform);
+        } else {
+            RefreshTransform(Transform::IDENTITY);
+        }
+    }
+
+    void RefreshTransform(Transform const& p_parent_transform) {
+        global_transform = p_parent_transform * local_transform;
+        for (auto child : children) {
+            child->RefreshTransform(global_transform);
+        }
+    }
+
+    void Move(Vec3 p_offset) {
+        local_transform.position += p_offset;
+        RefreshTransform();
+    }
+};
+
+}  // namespace Legacy
+
+constexpr uint NODE_COUNT = 100000;
+
+Transform RandomTransform(std::mt19937& p_random) {
+    std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+    return Transform(
+        Vec3(offset(p_random), offset(p_random), offset(p_random)),
+        Quaternion(Vec3(0.0f, offset(p_random), 0.0f)),
+        1.0f);
+}
+
+// Random recursive tree, every node picks a parent among the nodes created
+// before it. Depth grows with the log of the node count.
+std::vector<uint> MakeParents() {
+    std::mt19937 random(1);
+    std::vector<uint> parents(NODE_COUNT, TransformHierarchy::INVALID_ID);
+    for (uint i = 1; i < NODE_COUNT; ++i) {
+        parents[i] = std::uniform_int_distribution<uint>(0, i - 1)(random);
+    }
+    return parents;
+}
+
+std::vector<uint> PickMoving(uint p_percent) {
+    std::mt19937 random(2);
+    std::uniform_int_distribution<uint> pick(0, NODE_COUNT - 1);
+    std::vector<uint> moving(NODE_COUNT * p_percent / 100);
+    for (uint& node : moving) {
+        node = pick(random);
+    }
+    return moving;
+}
+
+void Hierarchy(benchmark::State& p_state) {
+    const std::vector<uint> parents = MakeParents();
+    const std::vector<uint> moving = PickMoving(p_state.range(0));
+    std::mt19937 random(3);
+
+    TransformHierarchy hierarchy;
+    std::vector<uint> ids(NODE_COUNT);
+    for (uint i = 0; i < NODE_COUNT; ++i) {
+        ids[i] = hierarchy.Create();
+        hierarchy.SetLocal(ids[i], RandomTransform(random));
+        if (parents[i] != TransformHierarchy::INVALID_ID) {
+            hierarchy.SetParent(ids[i], ids[parents[i]]);
+        }
+    }
+    hierarchy.Update();
+
+    const Vec3 step(0.01f, 0.0f, 0.0f);
+    for (auto _ : p_state) {
+        for (const uint node : moving) {
+            Transform transform = hierarchy.GetLocal(ids[node]);
+            transform.position += step;
+            hierarchy.SetLocal(ids[node], transform);
+        }
+        hierarchy.Update();
+        benchmark::DoNotOptimize(hierarchy.GetChanged().data());
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * moving.size());
+}
+
+void LegacyTree(benchmark::State& p_state) {
+    const std::vector<uint> parents = MakeParents();
+    const std::vector<uint> moving = PickMoving(p_state.range(0));
+    std::mt19937 random(3);
+
+    std::vector<std::shared_ptr<Legacy::Node>> nodes(NODE_COUNT);
+    for (uint i = 0; i < NODE_COUNT; ++i) {
+        nodes[i] = std::make_shared<Legacy::Node>();
+        nodes[i]->local_transform = RandomTransform(random);
+        if (parents[i] != TransformHierarchy::INVALID_ID) {
+            nodes[i]->parent = nodes[parents[i]];
+            nodes[parents[i]]->children.push_back(nodes[i]);
+        }
+    }
+    nodes[0]->RefreshTransform();
+
+    const Vec3 step(0.01f, 0.0f, 0.0f);
+    for (auto _ : p_state) {
+        for (const uint node : moving) {
+            nodes[node]->Move(step);
+        }
+        // What the renderer did for a single viewport
+        nodes[0]->RefreshTransform();
+        benchmark::DoNotOptimize(nodes[0]->global_transform);
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * moving.size());
+}
+
+}  // namespace
+
+// Percentage of nodes moving per frame
+BENCHMARK(Hierarchy)->Arg(1)->Arg(10)->Arg(100)->Unit(benchmark::kMicrosecond);
+BENCHMARK(LegacyTree)->Arg(1)->Arg(10)->Arg(100)->Unit(benchmark::kMicrosecond);
\ No newline at end of file
@@ -12,11 +12,12 @@ extern App* gApp;
 
 void Gauge::AABBGizmo::Draw() {
     const AABB transformed_aabb = node->GetGlobalTransform() * aabb;
+    const Vec3 extent = transformed_aabb.GetExtent();
     Mat4 transform{};
-    transform[0][0] = transformed_aabb.extent.x;
-    transform[1][1] = transformed_aabb.extent.y;
-    transform[2][2] = transformed_aabb.extent.z;
-    transform[3] = Vec4(transformed_aabb.position, 1.0);
+    transform[0][0] = extent.x;
+    transform[1][1] = extent.y;
+    transform[2][2] = extent.z;
+    transform[3] = Vec4(transformed_aabb.GetCenter(), 1.0);
     auto renderer = static_cast<RendererVulkan*>(&(*gApp->renderer));
     renderer->GetShader<DebugLineShader>()->objects.emplace_back(
         DebugLineShader::DrawObject{
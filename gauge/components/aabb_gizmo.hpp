@@ -12,10 +12,12 @@ struct AABBGizmo final : public Component {
 
    public:
     virtual void Draw() override;
+    virtual uint GetUpdateAccess() const override { return UpdateAccess::NONE; }
     AABBGizmo() {}
     AABBGizmo(AABB p_aabb) : Component(false, false), aabb(p_aabb) {}
 
     static void StaticInitialize() {}
+    static constexpr bool CONTIGUOUS_STORAGE = true;
 };
 
 }  // namespace Gauge
\ No newline at end of file
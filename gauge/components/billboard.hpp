@@ -15,10 +15,12 @@ struct Billboard final : public Component {
 
    public:
     virtual void Draw() override;
+    virtual uint GetUpdateAccess() const override { return UpdateAccess::NONE; }
 
     Billboard(Vec2 p_size) : size(p_size) {}
 
     static void StaticInitialize() {}
+    static constexpr bool CONTIGUOUS_STORAGE = true;
     COMPONENT_FACTORY_HEADER(Billboard)
 };
 
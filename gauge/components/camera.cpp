@@ -138,7 +138,7 @@ Quaternion Camera::GetPlanarRotation() const {
 }
 
 Mat4 Camera::GetTransformMatrix() const {
-    return glm::translate(Mat4(1.0f), node->global_transform.position) *
+    return glm::translate(Mat4(1.0f), node->GetGlobalTransform().position) *
            glm::toMat4(glm::angleAxis(yaw, Vec3::DOWN) *
                        glm::angleAxis(pitch, Vec3::RIGHT)) *
            glm::translate(Mat4(1.0f), Vec3::BACK * distance);
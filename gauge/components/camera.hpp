@@ -29,6 +29,7 @@ struct Camera final : public Component {
 
     virtual void Initialize() final override;
     virtual void Update(float delta) final override;
+    virtual uint GetUpdateAccess() const final override { return UpdateAccess::MAIN_THREAD | UpdateAccess::TRANSFORM_READ | UpdateAccess::TRANSFORM_WRITE; }
 
     void GrabMouse();
     void ReleaseMouse();
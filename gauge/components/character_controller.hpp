@@ -18,6 +18,7 @@ struct CharacterController final : public Component {
 
     virtual void Initialize() final override;
     virtual void Update(float delta) final override;
+    virtual uint GetUpdateAccess() const final override { return UpdateAccess::MAIN_THREAD | UpdateAccess::PHYSICS | UpdateAccess::TRANSFORM_READ | UpdateAccess::TRANSFORM_WRITE; }
 
     static void StaticInitialize() {}
     COMPONENT_FACTORY_HEADER(CharacterController);
@@ -1,5 +1,6 @@
 #include "component.hpp"
 
+#include <gauge/scene/property_blob.hpp>
 #include <gauge/scene/yaml.hpp>
 
 #include <print>
@@ -13,6 +14,11 @@ StringID::Map<Component::CreateFunction>& Component::GetCreateFunctions() {
     return create_functions;
 }
 
+StringID::Map<Component::BinaryCreateFunction>& Component::GetBinaryCreateFunctions() {
+    static StringID::Map<Component::BinaryCreateFunction> create_functions;
+    return create_functions;
+}
+
 bool Component::RegisterType(StringID p_name, Component::CreateFunction p_create_function) {
     std::println("Registering component: {}", p_name);
     if (Component::GetCreateFunctions().contains(p_name)) {
@@ -29,4 +35,32 @@ void Component::Create(StringID p_name, YAML::Node p_data, Ref<Node> r_node) {
         return;
     }
     Component::GetCreateFunctions()[p_name](p_data, r_node);
+}
+
+bool Component::RegisterBinaryType(StringID p_name, Component::BinaryCreateFunction p_create_function) {
+    if (Component::GetBinaryCreateFunctions().contains(p_name)) {
+        return false;
+    }
+
+    Component::GetBinaryCreateFunctions()[p_name] = p_create_function;
+    return true;
+}
+
+void Component::Create(StringID p_name, const PropertyBlob& p_data, Ref<Node> r_node) {
+    const BinaryCreateFunction create_function = FindBinaryCreateFunction(p_name);
+    if (create_function == nullptr) {
+        Component::Create(p_name, p_data.ToYAML(), r_node);
+        return;
+    }
+    create_function(p_data, r_node);
+}
+
+Component::CreateFunction Component::FindCreateFunction(StringID p_name) {
+    const auto it = Component::GetCreateFunctions().find(p_name);
+    return it != Component::GetCreateFunctions().end() ? it->second : nullptr;
+}
+
+Component::BinaryCreateFunction Component::FindBinaryCreateFunction(StringID p_name) {
+    const auto it = Component::GetBinaryCreateFunctions().find(p_name);
+    return it != Component::GetBinaryCreateFunctions().end() ? it->second : nullptr;
 }
\ No newline at end of file
@@ -11,6 +11,7 @@ class Node;
 namespace Gauge {
 
 class Node;
+class PropertyBlob;
 
 // --- Factory macros ---
 // To be included in every component's header.
@@ -30,15 +31,69 @@ class Node;
     }                                                                       \
     bool class ::registered = Component::RegisterType(#name, &Instantiate); \
     class ::class(YAML::Node p_data)
+
+// Optional, lets baked scenes create the component straight from its
+// PropertyBlob. Components without it are created from the blob converted
+// to YAML. Include after COMPONENT_FACTORY_HEADER.
+#define COMPONENT_FACTORY_BINARY_HEADER(class)                                   \
+    class(const PropertyBlob& p_data);                                           \
+    static void InstantiateBinary(const PropertyBlob& p_data, Ref<Node> p_node); \
+    static bool registered_binary;
+
+// Followed by { code initializing component using the PropertyBlob p_data }
+#define COMPONENT_FACTORY_BINARY_IMPL(class, name)                                             \
+    void class ::InstantiateBinary(const PropertyBlob& p_data, Ref<Node> p_node) {             \
+        auto component = p_node->AddComponent<class>(p_data);                                  \
+    }                                                                                          \
+    bool class ::registered_binary = Component::RegisterBinaryType(#name, &InstantiateBinary); \
+    class ::class(const PropertyBlob& p_data)
 // ---- End macro magic ---
 
+// Shared state touched by a component's Update. The UpdateScheduler runs
+// component types whose access does not conflict at the same time and
+// updates the instances of a type in parallel where that is safe.
+namespace UpdateAccess {
+enum : uint {
+    NONE = 0,
+    // Reads global transforms, including that of its own node
+    TRANSFORM_READ = 1 << 0,
+    // Writes the local transform of its own node
+    TRANSFORM_WRITE = 1 << 1,
+    // Calls into the physics backend, instances run one at a time
+    PHYSICS = 1 << 2,
+    // Appends to the renderer's thread-safe per-frame lists, never conflicts
+    RENDER_STATE = 1 << 3,
+    // Input, windowing and the like, instances run one at a time on the
+    // thread calling Node::Update
+    MAIN_THREAD = 1 << 4,
+    // Conflicts with every other type, e.g. when creating or removing nodes
+    EXCLUSIVE = 1 << 5 | MAIN_THREAD,
+};
+}
+
+// Unique per component type without RTTI or hashing. The tag must not be
+// const: identical constants may be merged by the compiler or linker
+// (ICF), which would give different types the same address.
+template <typename C>
+inline char component_type_tag = 0;
+
+template <typename C>
+constexpr const void* GetComponentType() {
+    return &component_type_tag<C>;
+}
+
 struct Component {
     using CreateFunction = void (*)(YAML::Node, std::shared_ptr<Node>);
+    using BinaryCreateFunction = void (*)(const PropertyBlob&, std::shared_ptr<Node>);
 
     StringID name;
     bool visible = true;
     bool active = true;
+    // Drawn type by type through its ComponentStorage rather than by Node::Draw
+    bool stored_contiguously = false;
     Node* node;
+    // Set by Node::AddComponent, see GetComponentType
+    const void* type = nullptr;
 
     virtual void Initialize() {}
     virtual void Update(float delta) {}
@@ -46,17 +101,29 @@ struct Component {
     virtual void Draw() {}
     virtual void Finalize() {}
 
+    // Components that do not declare their access are updated alone
+    virtual uint GetUpdateAccess() const { return UpdateAccess::EXCLUSIVE; }
+    // False while resources are still loading, streamed scenes are only
+    // attached once every component in them is loaded
+    virtual bool IsLoaded() const { return true; }
+
     void SetNode(Node* p_node) {
         node = p_node;
     }
 
     static bool RegisterType(StringID p_name, CreateFunction);
+    static bool RegisterBinaryType(StringID p_name, BinaryCreateFunction);
     static void Create(StringID p_name, YAML::Node p_data, Ref<Node> r_node);
+    static void Create(StringID p_name, const PropertyBlob& p_data, Ref<Node> r_node);
+    // nullptr if p_name has no factory of that kind
+    static CreateFunction FindCreateFunction(StringID p_name);
+    static BinaryCreateFunction FindBinaryCreateFunction(StringID p_name);
 
     Component(bool p_visible = true, bool p_active = true) : visible(p_visible), active(p_active) {}
 
    protected:
     static StringID::Map<Component::CreateFunction>& GetCreateFunctions();
+    static StringID::Map<Component::BinaryCreateFunction>& GetBinaryCreateFunctions();
 };
 
 template <typename C>
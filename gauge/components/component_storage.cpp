@@ -0,0 +1,15 @@
+#include "component_storage.hpp"
+
+#include <gauge/components/component.hpp>
+#include <gauge/scene/node.hpp>
+
+using namespace Gauge;
+
+std::vector<ComponentStorageBase*>& ComponentStorageBase::GetAll() {
+    static std::vector<ComponentStorageBase*> storages;
+    return storages;
+}
+
+bool ComponentStorageBase::IsVisibleBelow(const Component& p_component, const Node& p_root) {
+    return p_component.visible && p_component.node != nullptr && p_component.node->IsVisibleBelow(p_root);
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <gauge/common.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace Gauge {
+
+class Node;
+struct Component;
+
+// Type-erased view of a ComponentStorage so systems can walk all of them
+class ComponentStorageBase {
+   public:
+    // Draws every component in the storage that is visible below p_root
+    virtual void Draw(const Node& p_root) = 0;
+    virtual uint Count() const = 0;
+    virtual ~ComponentStorageBase() {}
+
+    // In order of first use
+    static std::vector<ComponentStorageBase*>& GetAll();
+
+   protected:
+    static bool IsVisibleBelow(const Component& p_component, const Node& p_root);
+};
+
+// Contiguous storage for all components of type C, used by Node::AddComponent
+// for types that set CONTIGUOUS_STORAGE. Components are packed into fixed-size
+// chunks so their addresses stay stable for the Refs handed out, while
+// iterating a type still walks memory linearly instead of chasing pointers.
+// Freed slots are reused before the storage grows.
+template <typename C>
+class ComponentStorage final : public ComponentStorageBase {
+   public:
+    static constexpr uint CHUNK_SIZE = 256;
+
+   private:
+    struct Chunk {
+        alignas(C) std::byte data[CHUNK_SIZE * sizeof(C)];
+        std::array<bool, CHUNK_SIZE> live{};
+
+        C* Get(uint p_index) { return std::launder(reinterpret_cast<C*>(data) + p_index); }
+    };
+
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    std::vector<uint> free_slots;
+    uint slot_count = 0;
+    uint live_count = 0;
+
+    void Destroy(uint p_slot);
+
+    ComponentStorage() { GetAll().push_back(this); }
+
+   public:
+    // The returned Ref gives the slot back when the last reference is gone
+    template <typename... Args>
+    Ref<C> Create(Args&&... p_arguments);
+
+    // Calls p_function(C&) for every live component in storage order
+    template <typename F>
+    void ForEach(F&& p_function);
+
+    virtual void Draw(const Node& p_root) override;
+    virtual uint Count() const override { return live_count; }
+
+    static ComponentStorage& Get();
+};
+
+template <typename C>
+concept IsContiguousComponent = requires {
+    requires C::CONTIGUOUS_STORAGE;
+};
+
+template <typename C>
+ComponentStorage<C>& ComponentStorage<C>::Get() {
+    // Never destroyed, Refs held by globals may outlive static destruction
+    static ComponentStorage* storage = new ComponentStorage();
+    return *storage;
+}
+
+template <typename C>
+template <typename... Args>
+Ref<C> ComponentStorage<C>::Create(Args&&... p_arguments) {
+    uint slot;
+    if (!free_slots.empty()) {
+        slot = free_slots.back();
+        free_slots.pop_back();
+    } else {
+        slot = slot_count++;
+        if (slot / CHUNK_SIZE == chunks.size()) {
+            chunks.emplace_back(std::make_unique<Chunk>());
+        }
+    }
+
+    Chunk& chunk = *chunks[slot / CHUNK_SIZE];
+    C* component = new (chunk.Get(slot % CHUNK_SIZE)) C(std::forward<Args>(p_arguments)...);
+    component->stored_contiguously = true;
+    chunk.live[slot % CHUNK_SIZE] = true;
+    live_count++;
+
+    return Ref<C>(component, [slot](C*) {
+        ComponentStorage<C>::Get().Destroy(slot);
+    });
+}
+
+template <typename C>
+void ComponentStorage<C>::Destroy(uint p_slot) {
+    Chunk& chunk = *chunks[p_slot / CHUNK_SIZE];
+    chunk.Get(p_slot % CHUNK_SIZE)->~C();
+    chunk.live[p_slot % CHUNK_SIZE] = false;
+    live_count--;
+    free_slots.push_back(p_slot);
+}
+
+template <typename C>
+template <typename F>
+void ComponentStorage<C>::ForEach(F&& p_function) {
+    for (uint chunk_index = 0; chunk_index < chunks.size(); ++chunk_index) {
+        Chunk& chunk = *chunks[chunk_index];
+        const uint end = std::min(slot_count - chunk_index * CHUNK_SIZE, CHUNK_SIZE);
+        for (uint i = 0; i < end; ++i) {
+            if (chunk.live[i]) {
+                p_function(*chunk.Get(i));
+            }
+        }
+    }
+}
+
+template <typename C>
+void ComponentStorage<C>::Draw(const Node& p_root) {
+    ForEach([&p_root](C& p_component) {
+        if (IsVisibleBelow(p_component, p_root)) {
+            p_component.Draw();
+        }
+    });
+}
+
+}  // namespace Gauge
@@ -6,6 +6,7 @@
 #include <gauge/renderer/vulkan/common.hpp>
 #include <gauge/renderer/vulkan/renderer_vulkan.hpp>
 #include <gauge/scene/node.hpp>
+#include <gauge/scene/property_blob.hpp>
 #include <gauge/scene/yaml.hpp>
 
 #include <print>
@@ -25,14 +26,15 @@ void PointLight::Initialize() {
 
 void PointLight::Update(float delta) {
     auto renderer = static_cast<RendererVulkan*>(&(*gApp->renderer));
-    auto& scene = renderer->render_state.scenes[0];
-    scene.point_lights[scene.active_point_lights] = GPUPointLight{
-        .position = node->GetGlobalTransform().position,
-        .range = range,
-        .color = color,
-        .intensity = intensity,
-    };
-    scene.active_point_lights += 1;
+    renderer->render_state.point_lights.Append(RendererVulkan::QueuedPointLight{
+        .node_handle = node->handle.ToUint(),
+        .light = GPUPointLight{
+            .position = node->GetGlobalTransform().position,
+            .range = range,
+            .color = color,
+            .intensity = intensity,
+        },
+    });
 }
 
 void PointLight::Draw() {
@@ -48,4 +50,10 @@ COMPONENT_FACTORY_IMPL(PointLight, point_light) {
     if (p_data["intensity"]) {
         intensity = p_data["intensity"].as<float>();
     }
+}
+
+COMPONENT_FACTORY_BINARY_IMPL(PointLight, point_light) {
+    range = p_data.Get("range"_id, range);
+    color = p_data.Get("color"_id, color);
+    intensity = p_data.Get("intensity"_id, intensity);
 }
\ No newline at end of file
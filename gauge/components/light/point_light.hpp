@@ -16,10 +16,13 @@ struct PointLight final : public Component {
     virtual void Initialize() override;
     virtual void Draw() override;
     virtual void Update(float delta) override;
+    virtual uint GetUpdateAccess() const override { return UpdateAccess::TRANSFORM_READ | UpdateAccess::RENDER_STATE; }
 
     static void StaticInitialize() {}
+    static constexpr bool CONTIGUOUS_STORAGE = true;
 
     COMPONENT_FACTORY_HEADER(PointLight)
+    COMPONENT_FACTORY_BINARY_HEADER(PointLight)
 };
 
 }  // namespace Gauge
\ No newline at end of file
@@ -3,10 +3,10 @@
 #include <gauge/core/app.hpp>
 #include <gauge/math/transform.hpp>
 #include <gauge/renderer/renderer.hpp>
-#include <gauge/renderer/shaders/gizmo/gizmo_shader.hpp>
-#include <gauge/renderer/shaders/pbr/pbr_shader.hpp>
+#include <gauge/renderer/shaders/mesh_shader.hpp>
 #include <gauge/renderer/vulkan/renderer_vulkan.hpp>
 #include <gauge/scene/node.hpp>
+#include <gauge/scene/scene_bounds.hpp>
 
 #include <yaml-cpp/yaml.h>
 
@@ -14,26 +14,25 @@ using namespace Gauge;
 
 extern App* gApp;
 
+void MeshInstance::Initialize() {
+    SceneBounds::Get().Add(*node);
+}
+
 void MeshInstance::Draw() {
+    if (node != nullptr && !SceneBounds::Get().PassesCulling(node->transform_id)) {
+        return;
+    }
+    RendererVulkan& renderer = *static_cast<RendererVulkan*>(gApp->renderer.get());
+    const Transform transform = node ? node->GetGlobalTransform() : Transform();
+    const uint64_t node_handle = node ? node->handle.ToUint() : 0;
     for (const auto& surface : surfaces) {
-        auto renderer = static_cast<RendererVulkan*>(&(*gApp->renderer));
-        auto shader_name = std::string(surface.shader_id);
-        if (shader_name == "PBR") {
-            renderer->GetShader<PBRShader>()->objects.emplace_back(
-                PBRShader::DrawObject{
-                    .primitive = surface.primitive,
-                    .material = surface.material,
-                    .transform = node ? node->global_transform : Transform(),
-                    .node_handle = node ? node->handle.ToUint() : 0,
-                });
-        } else if (shader_name == "Gizmo") {
-            renderer->GetShader<GizmoShader>()->objects.emplace_back(
-                GizmoShader::DrawObject{
-                    .primitive = surface.primitive,
-                    .material = surface.material,
-                    .transform = node ? node->global_transform : Transform(),
-                    .node_handle = node ? node->handle.ToUint() : 0,
-                });
+        if (surface.draw_queue != RendererVulkan::INVALID_DRAW_QUEUE) {
+            renderer.SubmitMesh(surface.draw_queue, MeshShader::DrawObject{
+                                                        .primitive = surface.primitive,
+                                                        .material = surface.material,
+                                                        .transform = transform,
+                                                        .node_handle = node_handle,
+                                                    });
         }
     }
 }
@@ -5,7 +5,6 @@
 #include <gauge/core/handle.hpp>
 
 #include <vector>
-#include "gauge/core/string_id.hpp"
 #include "gauge/renderer/common.hpp"
 
 namespace Gauge {
@@ -16,13 +15,17 @@ struct MeshInstance final : public Component {
     struct Surface {
         Handle<GPUMesh> primitive;
         Handle<GPUMaterial> material;
-        StringID shader_id;
+        // From RendererVulkan::GetDrawQueue
+        uint draw_queue;
     };
     std::vector<Surface> surfaces;
 
    public:
     static void StaticInitialize() {}
+    static constexpr bool CONTIGUOUS_STORAGE = true;
+    virtual void Initialize() override;
     virtual void Draw() override;
+    virtual uint GetUpdateAccess() const override { return UpdateAccess::NONE; }
 
     COMPONENT_FACTORY_HEADER(MeshInstance)
 };
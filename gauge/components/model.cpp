@@ -3,6 +3,7 @@
 #include <gauge/core/resource_manager.hpp>
 #include <gauge/renderer/gltf.hpp>
 #include <gauge/scene/node.hpp>
+#include <gauge/scene/property_blob.hpp>
 #include <gauge/scene/yaml.hpp>
 
 #include <print>
@@ -11,11 +12,30 @@
 using namespace Gauge;
 
 void ModelComponent::Initialize() {
-    const auto model_node = ResourceManager::Load<glTF>(path)->CreateNode().value();
+    model = ResourceManager::LoadAsync<glTF>(path);
+}
+
+void ModelComponent::Update(float delta) {
+    if (instantiated || !model.IsReady()) {
+        return;
+    }
+    instantiated = true;
+
+    const glTF* gltf = model.Get();
+    if (gltf == nullptr) {
+        std::println("Could not instantiate model {}", path);
+        return;
+    }
+    const auto model_node = gltf->CreateNode().value();
     node->AddChild(model_node);
 }
 
 COMPONENT_FACTORY_IMPL(ModelComponent, model) {
     path = p_data["path"].as<std::string>();
     generate_collisions = p_data["collisions"].IsDefined() && p_data["collisions"].as<bool>();
+}
+
+COMPONENT_FACTORY_BINARY_IMPL(ModelComponent, model) {
+    path = p_data.Get<std::string>("path"_id, "");
+    generate_collisions = p_data.Get("collisions"_id, false);
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <gauge/components/component.hpp>
+#include <gauge/core/resource_manager.hpp>
+#include <gauge/renderer/gltf.hpp>
 
 #include <string>
 
@@ -10,12 +12,19 @@ struct ModelComponent final : public Component {
    public:
     std::string path;
     bool generate_collisions{};
+    ResourceManager::Future<glTF> model;
+    bool instantiated{};
 
     void Initialize() final override;
+    void Update(float delta) final override;
+    // Instantiating the model adds nodes to the tree
+    uint GetUpdateAccess() const final override { return UpdateAccess::EXCLUSIVE; }
+    bool IsLoaded() const final override { return model.IsReady(); }
 
    public:
     static void StaticInitialize() {}
     COMPONENT_FACTORY_HEADER(ModelComponent)
+    COMPONENT_FACTORY_BINARY_HEADER(ModelComponent)
 };
 
 }  // namespace Gauge
\ No newline at end of file
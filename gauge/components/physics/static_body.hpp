@@ -14,6 +14,7 @@ struct StaticBody final : public Component {
    public:
     virtual void Initialize() final override;
     virtual void Update(float delta) final override;
+    virtual uint GetUpdateAccess() const final override { return UpdateAccess::NONE; }
 
     StaticBody(Physics::ShapeHandle p_shape = 0, Physics::ShapeHandle p_body = 0)
         : Component(false, false), shape(p_shape) {}
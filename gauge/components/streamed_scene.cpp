@@ -0,0 +1,36 @@
+#include "streamed_scene.hpp"
+
+#include <gauge/scene/node.hpp>
+#include <gauge/scene/property_blob.hpp>
+#include <gauge/scene/world_streamer.hpp>
+#include <gauge/scene/yaml.hpp>
+
+using namespace Gauge;
+
+void StreamedScene::Initialize() {
+    // Lets the bounds show up in the node's AABB before anything is loaded
+    node->aabb.Grow(bounds);
+    WorldStreamer::Get().Register(this);
+}
+
+StreamedScene::~StreamedScene() {
+    WorldStreamer::Get().Unregister(this);
+}
+
+COMPONENT_FACTORY_IMPL(StreamedScene, streamed_scene) {
+    path = p_data["scene"].as<std::string>();
+    if (p_data["center"] && p_data["extent"]) {
+        bounds = AABB(p_data["center"].as<Vec3>(), p_data["extent"].as<Vec3>());
+    }
+    if (p_data["radius"]) {
+        radius = p_data["radius"].as<float>();
+    }
+}
+
+COMPONENT_FACTORY_BINARY_IMPL(StreamedScene, streamed_scene) {
+    path = p_data.Get<std::string>("scene"_id, "");
+    if (p_data.Has("center"_id) && p_data.Has("extent"_id)) {
+        bounds = AABB(p_data.Get("center"_id, Vec3(0.0f)), p_data.Get("extent"_id, Vec3(1.0f)));
+    }
+    radius = p_data.Get("radius"_id, radius);
+}
\ No newline at end of file
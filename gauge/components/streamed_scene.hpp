@@ -0,0 +1,51 @@
+#pragma once
+
+#include <gauge/common.hpp>
+#include <gauge/components/component.hpp>
+#include <gauge/core/resource_manager.hpp>
+#include <gauge/renderer/aabb.hpp>
+#include <gauge/scene/scene.hpp>
+
+#include <optional>
+#include <string>
+
+namespace Gauge {
+
+// Placeholder for a subscene that the WorldStreamer loads and attaches as a
+// child of this node once a viewer comes within radius of its bounds
+struct StreamedScene final : public Component {
+    enum class State {
+        UNLOADED,
+        LOADING,
+        // Being instantiated a few nodes per frame
+        INSTANTIATING,
+        // Instantiated, waiting for the resources of its components
+        INSTANTIATED,
+        ATTACHED,
+        FAILED,
+    };
+
+    std::string path;
+    // Local to the node
+    AABB bounds{Vec3(0.0f), Vec3(1.0f)};
+    float radius = 50.0f;
+
+    // Managed by the WorldStreamer
+    State state = State::UNLOADED;
+    ResourceManager::Future<Scene> scene;
+    std::optional<BakedScene::Instancer> instancer;
+    Ref<Node> instance;
+
+   public:
+    virtual void Initialize() override;
+    // Streaming happens in WorldStreamer::Update, not in the update phase
+    virtual uint GetUpdateAccess() const override { return UpdateAccess::NONE; }
+    ~StreamedScene();
+
+    static void StaticInitialize() {}
+
+    COMPONENT_FACTORY_HEADER(StreamedScene)
+    COMPONENT_FACTORY_BINARY_HEADER(StreamedScene)
+};
+
+}  // namespace Gauge
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <span>
+
+namespace Gauge {
+
+// Fixed-capacity list that any number of threads can append to without
+// locking. Reading and clearing must not overlap with appends; the caller
+// is expected to synchronize, e.g. by waiting on the jobs that append.
+template <typename T, uint N>
+class AppendBuffer {
+    std::array<T, N> items{};
+    std::atomic<uint> count = 0;
+
+   public:
+    // Returns false if the buffer is full
+    bool Append(const T& p_item) {
+        const uint index = count.fetch_add(1, std::memory_order_relaxed);
+        if (index >= N) {
+            return false;
+        }
+        items[index] = p_item;
+        return true;
+    }
+
+    std::span<const T> Items() const {
+        return {items.data(), std::min(count.load(std::memory_order_relaxed), N)};
+    }
+
+    // Appends land in arbitrary order, e.g. sort them before use
+    std::span<T> Items() {
+        return {items.data(), std::min(count.load(std::memory_order_relaxed), N)};
+    }
+
+    void Clear() { count.store(0, std::memory_order_relaxed); }
+};
+
+}  // namespace Gauge
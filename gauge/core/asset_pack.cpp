@@ -0,0 +1,116 @@
+#include "asset_pack.hpp"
+
+#include <gauge/core/compression.hpp>
+#include <gauge/core/job_system.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <memory>
+
+using namespace Gauge;
+
+Result<AssetPack> AssetPack::Open(const std::string& p_path) {
+    auto mapped = FileSystem::Map(p_path);
+    CHECK_RET(mapped);
+
+    AssetPack pack{};
+    pack.file = std::move(mapped.value());
+    if (pack.file.Size() < sizeof(Header)) {
+        return Error(std::format("'{}' is not an asset pack", p_path));
+    }
+
+    const Header* header = reinterpret_cast<const Header*>(pack.file.Data());
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0) {
+        return Error(std::format("'{}' is not an asset pack", p_path));
+    }
+    if (header->version != VERSION) {
+        return Error(std::format("Asset pack '{}' has version {}, expected {}", p_path, header->version, VERSION));
+    }
+    if (header->chunk_table_offset + header->chunk_count * sizeof(Chunk) > pack.file.Size() ||
+        header->index_offset + header->entry_count * sizeof(Entry) > pack.file.Size()) {
+        return Error(std::format("Asset pack '{}' is truncated", p_path));
+    }
+
+    pack.chunks = std::span(reinterpret_cast<const Chunk*>(pack.file.Data() + header->chunk_table_offset), header->chunk_count);
+    pack.entries = std::span(reinterpret_cast<const Entry*>(pack.file.Data() + header->index_offset), header->entry_count);
+    return pack;
+}
+
+std::string AssetPack::NormalizePath(std::string_view p_path) {
+    return std::filesystem::path(p_path).lexically_normal().generic_string();
+}
+
+const AssetPack::Entry* AssetPack::Find(uint64_t p_id) const {
+    auto entry = std::ranges::lower_bound(entries, p_id, {}, &Entry::id);
+    if (entry == entries.end() || entry->id != p_id) {
+        return nullptr;
+    }
+    return &*entry;
+}
+
+Result<FileSystem::MappedFile> AssetPack::Read(const Entry& p_entry) const {
+    if (p_entry.compression == Compression::NONE) {
+        return file.Slice(p_entry.offset, p_entry.size);
+    }
+    if (p_entry.compression != Compression::LZ4) {
+        return Error(std::format("Unknown compression {} in asset pack", uint(p_entry.compression)));
+    }
+
+    std::shared_ptr<char[]> buffer(new char[p_entry.size]);
+
+    // Workers and the calling thread claim chunks from a shared counter. The
+    // caller only waits for chunks that were already claimed, so this can not
+    // deadlock when called from a worker thread itself.
+    struct Decompression {
+        FileSystem::MappedFile source;
+        std::span<const Chunk> chunks;
+        char* output;
+        std::atomic<uint> next_chunk = 0;
+        std::atomic<uint> finished_chunks = 0;
+        std::atomic<bool> failed = false;
+
+        void Run() {
+            uint index;
+            while ((index = next_chunk.fetch_add(1)) < chunks.size()) {
+                const Chunk& chunk = chunks[index];
+                const char* input = source.Data() + chunk.offset;
+                char* destination = output + size_t(index) * CHUNK_SIZE;
+                if (chunk.compressed_size == chunk.size) {
+                    std::memcpy(destination, input, chunk.size);
+                } else if (!Gauge::Compression::DecompressLZ4({input, chunk.compressed_size}, {destination, chunk.size})) {
+                    failed = true;
+                }
+                finished_chunks.fetch_add(1);
+                finished_chunks.notify_all();
+            }
+        }
+    };
+
+    auto decompression = std::make_shared<Decompression>();
+    decompression->source = file;
+    decompression->chunks = chunks.subspan(p_entry.first_chunk, p_entry.chunk_count);
+    decompression->output = buffer.get();
+
+    const uint helper_count = p_entry.chunk_count > 1 ? std::min(p_entry.chunk_count - 1, JobSystem::Get().GetThreadCount()) : 0;
+    for (uint i = 0; i < helper_count; ++i) {
+        // Keeps the buffer alive in case a helper starts after Read returned.
+        // Background jobs, so that threads waiting on frame work don't pick them up.
+        JobSystem::Get().SubmitBackground([decompression, buffer]() {
+            decompression->Run();
+        });
+    }
+    decompression->Run();
+
+    uint finished;
+    while ((finished = decompression->finished_chunks.load()) < p_entry.chunk_count) {
+        decompression->finished_chunks.wait(finished);
+    }
+
+    if (decompression->failed) {
+        return Error("Could not decompress file from asset pack");
+    }
+    return FileSystem::MappedFile(buffer.get(), p_entry.size, buffer);
+}
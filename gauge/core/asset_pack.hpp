@@ -0,0 +1,74 @@
+#pragma once
+
+#include <gauge/common.hpp>
+#include <gauge/core/filesystem.hpp>
+#include <gauge/core/string_id.hpp>
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace Gauge {
+
+// Read-only archive of asset files, memory-mapped as a whole. Files are looked
+// up by the StringID of their normalized path through an index sorted by ID.
+// Layout: Header | file data | chunk table | index
+// Uncompressed files are stored contiguously and read without copying,
+// compressed files are split into chunks that are decompressed in parallel.
+struct AssetPack {
+    static constexpr char MAGIC[4] = {'G', 'P', 'A', 'K'};
+    static constexpr uint VERSION = 1;
+    static constexpr uint CHUNK_SIZE = 256 * 1024;
+    static constexpr uint ALIGNMENT = 16;
+
+    enum class Compression : uint32_t {
+        NONE = 0,
+        LZ4 = 1,
+    };
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t entry_count;
+        uint32_t chunk_count;
+        uint64_t chunk_table_offset;
+        uint64_t index_offset;
+    };
+
+    struct Entry {
+        uint64_t id;
+        // Start of the file data, or of the first chunk for compressed files
+        uint64_t offset;
+        uint64_t size;
+        uint32_t first_chunk;
+        uint32_t chunk_count;
+        Compression compression;
+        uint32_t reserved;
+    };
+
+    // Chunks with compressed_size == size are stored uncompressed
+    struct Chunk {
+        uint64_t offset;
+        uint32_t compressed_size;
+        uint32_t size;
+    };
+
+    static_assert(sizeof(Header) == 32);
+    static_assert(sizeof(Entry) == 40);
+    static_assert(sizeof(Chunk) == 16);
+
+    FileSystem::MappedFile file;
+    std::span<const Entry> entries;
+    std::span<const Chunk> chunks;
+
+    static Result<AssetPack> Open(const std::string& p_path);
+    // Key under which a file is stored, relative paths with '/' separators
+    static std::string NormalizePath(std::string_view p_path);
+
+    const Entry* Find(uint64_t p_id) const;
+    const Entry* Find(StringID p_id) const { return Find(p_id.id); }
+    Result<FileSystem::MappedFile> Read(const Entry& p_entry) const;
+};
+
+}  // namespace Gauge
@@ -0,0 +1,176 @@
+#include "compression.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace Gauge;
+
+namespace {
+
+constexpr size_t MIN_MATCH = 4;
+// The format requires the last 5 bytes to be literals and the last match to
+// start at least 12 bytes before the end of the block
+constexpr size_t LAST_LITERALS = 5;
+constexpr size_t MATCH_FIND_LIMIT = 12;
+constexpr size_t MAX_OFFSET = 65535;
+constexpr uint HASH_BITS = 12;
+
+uint32_t Read32(const char* p_data) {
+    uint32_t value;
+    std::memcpy(&value, p_data, sizeof(value));
+    return value;
+}
+
+uint32_t Hash(uint32_t p_sequence) {
+    return (p_sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+char* WriteLength(char* r_output, size_t p_length) {
+    while (p_length >= 255) {
+        *r_output++ = static_cast<char>(255);
+        p_length -= 255;
+    }
+    *r_output++ = static_cast<char>(p_length);
+    return r_output;
+}
+
+char* WriteSequence(char* r_output, const char* p_literals, size_t p_literal_length, size_t p_offset, size_t p_match_length) {
+    char* token = r_output++;
+    uint8_t token_value = 0;
+
+    if (p_literal_length >= 15) {
+        token_value = 15 << 4;
+        r_output = WriteLength(r_output, p_literal_length - 15);
+    } else {
+        token_value = p_literal_length << 4;
+    }
+    std::memcpy(r_output, p_literals, p_literal_length);
+    r_output += p_literal_length;
+
+    if (p_match_length > 0) {
+        *r_output++ = static_cast<char>(p_offset & 0xFF);
+        *r_output++ = static_cast<char>(p_offset >> 8);
+        const size_t match_length = p_match_length - MIN_MATCH;
+        if (match_length >= 15) {
+            token_value |= 15;
+            r_output = WriteLength(r_output, match_length - 15);
+        } else {
+            token_value |= match_length;
+        }
+    }
+
+    *token = static_cast<char>(token_value);
+    return r_output;
+}
+
+}  // namespace
+
+size_t Compression::CompressBoundLZ4(size_t p_size) {
+    return p_size + p_size / 255 + 16;
+}
+
+size_t Compression::CompressLZ4(std::span<const char> p_source, std::span<char> r_destination) {
+    const char* source = p_source.data();
+    const size_t size = p_source.size();
+    char* output = r_destination.data();
+
+    size_t anchor = 0;
+    if (size > MATCH_FIND_LIMIT) {
+        std::vector<uint32_t> table(1u << HASH_BITS, UINT32_MAX);
+        const size_t match_limit = size - LAST_LITERALS;
+        size_t position = 0;
+        while (position < size - MATCH_FIND_LIMIT) {
+            const uint32_t sequence = Read32(source + position);
+            const uint32_t hash = Hash(sequence);
+            const uint32_t candidate = table[hash];
+            table[hash] = position;
+
+            if (candidate == UINT32_MAX || position - candidate > MAX_OFFSET || Read32(source + candidate) != sequence) {
+                position++;
+                continue;
+            }
+
+            size_t match_length = MIN_MATCH;
+            while (position + match_length < match_limit && source[candidate + match_length] == source[position + match_length]) {
+                match_length++;
+            }
+
+            output = WriteSequence(output, source + anchor, position - anchor, position - candidate, match_length);
+            position += match_length;
+            anchor = position;
+        }
+    }
+
+    output = WriteSequence(output, source + anchor, size - anchor, 0, 0);
+    return output - r_destination.data();
+}
+
+Result<> Compression::DecompressLZ4(std::span<const char> p_source, std::span<char> r_destination) {
+    const uint8_t* input = reinterpret_cast<const uint8_t*>(p_source.data());
+    const uint8_t* input_end = input + p_source.size();
+    char* output = r_destination.data();
+    char* output_end = output + r_destination.size();
+
+    auto read_length = [&](size_t& r_length) -> bool {
+        uint8_t byte;
+        do {
+            if (input >= input_end) {
+                return false;
+            }
+            byte = *input++;
+            r_length += byte;
+        } while (byte == 255);
+        return true;
+    };
+
+    while (input < input_end) {
+        const uint8_t token = *input++;
+
+        size_t literal_length = token >> 4;
+        if (literal_length == 15 && !read_length(literal_length)) {
+            return Error("Truncated LZ4 literal length");
+        }
+        if (literal_length > size_t(input_end - input) || literal_length > size_t(output_end - output)) {
+            return Error("LZ4 literals exceed block bounds");
+        }
+        std::memcpy(output, input, literal_length);
+        input += literal_length;
+        output += literal_length;
+
+        // The last sequence only contains literals
+        if (input == input_end) {
+            break;
+        }
+
+        if (input_end - input < 2) {
+            return Error("Truncated LZ4 match offset");
+        }
+        const size_t offset = input[0] | (input[1] << 8);
+        input += 2;
+        if (offset == 0 || offset > size_t(output - r_destination.data())) {
+            return Error("Invalid LZ4 match offset");
+        }
+
+        size_t match_length = token & 15;
+        if (match_length == 15 && !read_length(match_length)) {
+            return Error("Truncated LZ4 match length");
+        }
+        match_length += MIN_MATCH;
+        if (match_length > size_t(output_end - output)) {
+            return Error("LZ4 match exceeds block bounds");
+        }
+
+        // Matches may overlap the bytes they produce, so copy byte by byte
+        const char* match = output - offset;
+        for (size_t i = 0; i < match_length; ++i) {
+            output[i] = match[i];
+        }
+        output += match_length;
+    }
+
+    if (output != output_end) {
+        return Error("LZ4 block is shorter than expected");
+    }
+    return {};
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <gauge/common.hpp>
+
+#include <cstddef>
+#include <span>
+
+namespace Gauge {
+
+// Minimal codec producing and consuming the LZ4 block format, so that data
+// compressed by the asset pack tool can also be inspected with the lz4 CLI.
+namespace Compression {
+
+// Worst case size of compressing p_size bytes
+size_t CompressBoundLZ4(size_t p_size);
+// Returns the number of bytes written to r_destination, which must hold at
+// least CompressBoundLZ4(p_source.size()) bytes
+size_t CompressLZ4(std::span<const char> p_source, std::span<char> r_destination);
+// r_destination must have exactly the uncompressed size
+Result<> DecompressLZ4(std::span<const char> p_source, std::span<char> r_destination);
+
+}  // namespace Compression
+
+}  // namespace Gauge
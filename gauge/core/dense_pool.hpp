@@ -0,0 +1,131 @@
+#pragma once
+
+#include "handle.hpp"
+
+#include <cstdlib>
+#include <print>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Gauge {
+
+// Sparse-set variant of Pool. Live elements are packed into a dense array so
+// they can be iterated linearly; handles go through an index indirection and
+// Free swaps the last element into the hole. Unlike Pool, element addresses
+// are not stable: pointers returned by Get are invalidated by Allocate/Free.
+template <typename T>
+struct DensePool {
+    static constexpr uint INVALID_INDEX = ~0u;
+
+    std::vector<T> dense;
+    std::vector<uint> dense_to_sparse;
+    // Position in the dense array for live slots, next free slot otherwise
+    std::vector<uint> sparse;
+    // Even for live slots, odd for free ones
+    std::vector<uint> generations;
+    uint free_head = INVALID_INDEX;
+
+    Handle<T> Allocate(T p_data);
+    T* Get(Handle<T> p_handle);
+    T* Get(uint64_t p_handle);
+    void Free(Handle<T> p_handle);
+    void Free(uint64_t p_handle);
+
+    uint Count() const { return dense.size(); }
+    Handle<T> GetHandle(uint p_dense_index) const;
+
+    std::span<T> Values() { return dense; }
+    std::span<const T> Values() const { return dense; }
+    auto begin() { return dense.begin(); }
+    auto end() { return dense.end(); }
+    auto begin() const { return dense.begin(); }
+    auto end() const { return dense.end(); }
+
+    DensePool(uint p_initial_size = 2048);
+};
+
+template <typename T>
+DensePool<T>::DensePool(uint p_initial_size) {
+    dense.reserve(p_initial_size);
+    dense_to_sparse.reserve(p_initial_size);
+    sparse.reserve(p_initial_size);
+    generations.reserve(p_initial_size);
+}
+
+template <typename T>
+Handle<T> DensePool<T>::Allocate(T p_data) {
+    uint index;
+    if (free_head != INVALID_INDEX) {
+        index = free_head;
+        free_head = sparse[index];
+        generations[index] = (generations[index] + 1) & Handle<T>::MAX_GENERATION;
+    } else {
+        if (sparse.size() == Handle<T>::MAX_INDEX) [[unlikely]] {
+            // Wrapping around would alias live handles
+            std::println("Gauge Error: DensePool ran out of handle indices");
+            std::abort();
+        }
+        index = sparse.size();
+        sparse.push_back(0);
+        generations.push_back(0);
+    }
+
+    sparse[index] = dense.size();
+    dense.emplace_back(std::move(p_data));
+    dense_to_sparse.push_back(index);
+    return {
+        .index = index,
+        .generation = generations[index],
+    };
+}
+
+template <typename T>
+T* DensePool<T>::Get(Handle<T> p_handle) {
+    if (p_handle.index >= sparse.size() || p_handle.generation != generations[p_handle.index]) {
+        return nullptr;
+    }
+    return &dense[sparse[p_handle.index]];
+}
+
+template <typename T>
+T* DensePool<T>::Get(uint64_t p_handle) {
+    return Get(Handle<T>::FromUint(p_handle));
+}
+
+template <typename T>
+void DensePool<T>::Free(Handle<T> p_handle) {
+    if (Get(p_handle) == nullptr) [[unlikely]] {
+        return;
+    }
+
+    const uint position = sparse[p_handle.index];
+    const uint last = dense.size() - 1;
+    if (position != last) {
+        dense[position] = std::move(dense[last]);
+        dense_to_sparse[position] = dense_to_sparse[last];
+        sparse[dense_to_sparse[position]] = position;
+    }
+    dense.pop_back();
+    dense_to_sparse.pop_back();
+
+    generations[p_handle.index] = (generations[p_handle.index] + 1) & Handle<T>::MAX_GENERATION;
+    sparse[p_handle.index] = free_head;
+    free_head = p_handle.index;
+}
+
+template <typename T>
+void DensePool<T>::Free(uint64_t p_handle) {
+    Free(Handle<T>::FromUint(p_handle));
+}
+
+template <typename T>
+Handle<T> DensePool<T>::GetHandle(uint p_dense_index) const {
+    const uint index = dense_to_sparse[p_dense_index];
+    return {
+        .index = index,
+        .generation = generations[index],
+    };
+}
+
+}  // namespace Gauge
\ No newline at end of file
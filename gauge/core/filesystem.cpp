@@ -1,12 +1,42 @@
 #include "filesystem.hpp"
 
 #include <gauge/common.hpp>
+#include <gauge/core/asset_pack.hpp>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+#include <filesystem>
+#include <format>
 #include <fstream>
 #include <ios>
+#include <mutex>
+#include <ranges>
+#include <shared_mutex>
 #include <vector>
 
 using namespace Gauge;
+using namespace Gauge::FileSystem;
+
+namespace {
+
+std::shared_mutex packs_mutex;
+std::vector<AssetPack> packs;
+
+const AssetPack::Entry* FindInPacks(const std::string& p_path, const AssetPack** r_pack) {
+    const uint64_t id = StringID::Hash(AssetPack::NormalizePath(p_path));
+    for (const AssetPack& pack : packs | std::views::reverse) {
+        if (const AssetPack::Entry* entry = pack.Find(id)) {
+            *r_pack = &pack;
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace
 
 Result<std::vector<char>>
 FileSystem::ReadFile(const std::string& p_path) {
@@ -20,4 +50,66 @@ FileSystem::ReadFile(const std::string& p_path) {
     file.close();
 
     return buffer;
-}
\ No newline at end of file
+}
+
+Result<MappedFile>
+FileSystem::Map(const std::string& p_path) {
+    {
+        std::shared_lock lock(packs_mutex);
+        const AssetPack* pack = nullptr;
+        if (const AssetPack::Entry* entry = FindInPacks(p_path, &pack)) {
+            return pack->Read(*entry);
+        }
+    }
+
+    const int file = open(p_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file < 0) {
+        return Error(std::format("Failed to open file '{}': {}", p_path, strerror(errno)));
+    }
+
+    struct stat file_stat{};
+    if (fstat(file, &file_stat) != 0) {
+        close(file);
+        return Error(std::format("Failed to stat file '{}': {}", p_path, strerror(errno)));
+    }
+
+    const size_t size = static_cast<size_t>(file_stat.st_size);
+    if (size == 0) {
+        // mmap does not accept empty mappings
+        close(file);
+        return MappedFile();
+    }
+
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    // The mapping keeps its own reference to the file
+    close(file);
+    if (data == MAP_FAILED) {
+        return Error(std::format("Failed to map file '{}': {}", p_path, strerror(errno)));
+    }
+
+    std::shared_ptr<const void> storage(data, [size](const void* p_data) {
+        munmap(const_cast<void*>(p_data), size);
+    });
+    return MappedFile(static_cast<const char*>(data), size, std::move(storage));
+}
+
+bool FileSystem::Exists(const std::string& p_path) {
+    {
+        std::shared_lock lock(packs_mutex);
+        const AssetPack* pack = nullptr;
+        if (FindInPacks(p_path, &pack) != nullptr) {
+            return true;
+        }
+    }
+    return std::filesystem::exists(p_path);
+}
+
+Result<> FileSystem::MountPack(const std::string& p_path) {
+    auto pack = AssetPack::Open(p_path);
+    CHECK_RET(pack);
+    std::println("Mounted asset pack {} with {} files", p_path, pack->entries.size());
+
+    std::unique_lock lock(packs_mutex);
+    packs.emplace_back(std::move(pack.value()));
+    return {};
+}
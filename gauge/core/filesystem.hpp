@@ -2,14 +2,49 @@
 
 #include <gauge/common.hpp>
 
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
 #include <vector>
 
 namespace Gauge {
 
 namespace FileSystem {
 
+// Read-only view of a file's contents in memory. Depending on where the file
+// came from, the storage is a file mapping, a region of a mounted asset pack
+// or a decompressed buffer; it is released with the last view referencing it.
+class MappedFile {
+    const char* data{};
+    size_t size{};
+    std::shared_ptr<const void> storage;
+
+   public:
+    std::span<const char> GetData() const { return {data, size}; }
+    const char* Data() const { return data; }
+    size_t Size() const { return size; }
+    bool IsEmpty() const { return size == 0; }
+
+    // View of a part of this file sharing its storage
+    MappedFile Slice(size_t p_offset, size_t p_size) const {
+        return MappedFile(data + p_offset, p_size, storage);
+    }
+
+    MappedFile() = default;
+    MappedFile(const char* p_data, size_t p_size, std::shared_ptr<const void> p_storage)
+        : data(p_data), size(p_size), storage(std::move(p_storage)) {}
+};
+
 Result<std::vector<char>> ReadFile(const std::string& p_path);
+// Looks up p_path in the mounted asset packs first, then maps it from disk
+Result<MappedFile> Map(const std::string& p_path);
+bool Exists(const std::string& p_path);
+
+// Makes the files of an asset pack available to Map and Exists. Packs mounted
+// later take precedence over earlier ones.
+Result<> MountPack(const std::string& p_path);
 
-}
+}  // namespace FileSystem
 
-}  // namespace Gauge
\ No newline at end of file
+}  // namespace Gauge
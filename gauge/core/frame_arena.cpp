@@ -0,0 +1,39 @@
+#include "frame_arena.hpp"
+
+#include <algorithm>
+
+using namespace Gauge;
+
+FrameArena::FrameArena(size_t p_capacity) : block(std::make_unique<std::byte[]>(p_capacity)),
+                                            capacity(p_capacity) {
+    overflow.reserve(16);
+}
+
+void* FrameArena::AllocateOverflow(size_t p_size, size_t p_alignment) {
+    // Over-allocate so the start can be aligned
+    const size_t size = p_size + p_alignment - 1;
+    std::byte* allocation = overflow.emplace_back(std::make_unique<std::byte[]>(size)).get();
+    overflow_bytes += size;
+    heap_allocations++;
+
+    const uintptr_t address = reinterpret_cast<uintptr_t>(allocation);
+    return allocation + (((address + p_alignment - 1) & ~(p_alignment - 1)) - address);
+}
+
+void FrameArena::Reset() {
+    last_frame = {
+        .used_bytes = offset + overflow_bytes,
+        .capacity = capacity,
+        .heap_allocations = heap_allocations,
+    };
+
+    if (!overflow.empty()) {
+        // Grow to the peak of this frame so the next one fits in the block
+        capacity = std::max(capacity * 2, offset + overflow_bytes);
+        block = std::make_unique<std::byte[]>(capacity);
+        overflow.clear();
+        overflow_bytes = 0;
+    }
+    offset = 0;
+    heap_allocations = 0;
+}
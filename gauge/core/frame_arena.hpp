@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Gauge {
+
+// Linear allocator for data that only lives for one frame. Allocations bump
+// an offset into a single block and are never freed individually; Reset
+// releases everything at once. When a frame needs more than the block holds
+// the overflow is served from the heap, and the next Reset grows the block
+// to the peak usage, so steady-state frames do not touch the heap at all.
+class FrameArena {
+   public:
+    struct Stats {
+        size_t used_bytes = 0;
+        size_t capacity = 0;
+        // Heap allocations made by the arena, zero once the block has grown
+        // to fit a frame
+        uint heap_allocations = 0;
+    };
+
+   private:
+    std::unique_ptr<std::byte[]> block;
+    size_t capacity = 0;
+    size_t offset = 0;
+
+    std::vector<std::unique_ptr<std::byte[]>> overflow;
+    size_t overflow_bytes = 0;
+    uint heap_allocations = 0;
+
+    Stats last_frame{};
+
+    void* AllocateOverflow(size_t p_size, size_t p_alignment);
+
+   public:
+    static constexpr size_t DEFAULT_CAPACITY = 256 * 1024;
+
+    void* Allocate(size_t p_size, size_t p_alignment = alignof(std::max_align_t));
+    // Invalidates every allocation made since the last reset
+    void Reset();
+
+    // Usage of the frame before the last reset
+    const Stats& GetStats() const { return last_frame; }
+
+    FrameArena(size_t p_capacity = DEFAULT_CAPACITY);
+
+    FrameArena(FrameArena&&) = default;
+    FrameArena& operator=(FrameArena&&) = default;
+};
+
+inline void* FrameArena::Allocate(size_t p_size, size_t p_alignment) {
+    const uintptr_t base = reinterpret_cast<uintptr_t>(block.get());
+    const size_t aligned = ((base + offset + p_alignment - 1) & ~(p_alignment - 1)) - base;
+    if (aligned + p_size > capacity) [[unlikely]] {
+        return AllocateOverflow(p_size, p_alignment);
+    }
+    offset = aligned + p_size;
+    return block.get() + aligned;
+}
+
+// Standard allocator backed by a FrameArena. Deallocation is a no-op, memory
+// is reclaimed when the arena is reset. Moving a container moves its arena
+// along, so a per-frame list can be rebound to a new arena with an
+// assignment.
+template <typename T>
+struct ArenaAllocator {
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    FrameArena* arena = nullptr;
+
+    T* allocate(size_t p_count) {
+        return static_cast<T*>(arena->Allocate(p_count * sizeof(T), alignof(T)));
+    }
+    void deallocate(T*, size_t) {}
+
+    ArenaAllocator() = default;
+    ArenaAllocator(FrameArena& p_arena) : arena(&p_arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& p_other) : arena(p_other.arena) {}
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& p_other) const { return arena == p_other.arena; }
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+}  // namespace Gauge
@@ -1,32 +1,42 @@
 #pragma once
 
-#include <hashtable.h>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 
 namespace Gauge {
 
+// Handles are packed into a single 64 bit value so they can be passed around
+// as plain integers (push constants, physics user data, readback buffers) and
+// converted back without losing the generation. The index is in the low and
+// the generation in the high 32 bits.
 template <typename T>
 struct Handle {
-    uint16_t index{};
-    uint16_t generation{};
+    // Pools never hand out MAX_INDEX, running out of indices is fatal
+    static constexpr uint MAX_INDEX = ~0u;
+    static constexpr uint MAX_GENERATION = ~0u;
+
+    uint32_t index{};
+    uint32_t generation{};
 
     inline operator uint() const {
         return index;
     }
 
+    bool operator==(const Handle<T>& rhs) const = default;
+
     size_t hash() const {
-        return std::hash<uint>()(index);
+        return std::hash<uint64_t>()(ToUint());
     }
 
-    inline uint ToUint() {
-        return index;  // TODO: take generation into account
+    inline uint64_t ToUint() const {
+        return (uint64_t(generation) << 32) | index;
     }
 
-    static inline Handle<T> FromUint(uint p_handle) {
+    static inline Handle<T> FromUint(uint64_t p_handle) {
         return Handle<T>{
-            .index = uint16_t(p_handle),
-            .generation = 0,  // TODO
+            .index = uint32_t(p_handle),
+            .generation = uint32_t(p_handle >> 32),
         };
     }
 };
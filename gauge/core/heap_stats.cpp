@@ -0,0 +1,67 @@
+#include "heap_stats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace Gauge;
+
+#if defined(TRACY_ENABLE) || !defined(NDEBUG)
+#define GAUGE_COUNT_HEAP_ALLOCATIONS
+
+namespace {
+std::atomic<uint64_t> allocation_count = 0;
+}  // namespace
+
+void* operator new(std::size_t p_size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(p_size == 0 ? 1 : p_size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t p_size, std::align_val_t p_alignment) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t alignment = std::max(std::size_t(p_alignment), sizeof(void*));
+    // aligned_alloc wants the size to be a multiple of the alignment
+    const std::size_t size = (std::max(p_size, std::size_t(1)) + alignment - 1) & ~(alignment - 1);
+    if (void* memory = std::aligned_alloc(alignment, size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p_memory) noexcept {
+    std::free(p_memory);
+}
+
+void operator delete(void* p_memory, std::size_t) noexcept {
+    std::free(p_memory);
+}
+
+void operator delete(void* p_memory, std::align_val_t) noexcept {
+    std::free(p_memory);
+}
+
+void operator delete(void* p_memory, std::size_t, std::align_val_t) noexcept {
+    std::free(p_memory);
+}
+#endif
+
+bool HeapStats::IsCounting() {
+#ifdef GAUGE_COUNT_HEAP_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint64_t HeapStats::GetAllocationCount() {
+#ifdef GAUGE_COUNT_HEAP_ALLOCATIONS
+    return allocation_count.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Gauge {
+
+namespace HeapStats {
+
+// Debug and Tracy builds replace the global operator new to count heap
+// allocations, so code that is meant to be allocation free per frame can be
+// checked. Always false and zero in other builds.
+bool IsCounting();
+// Allocations made through operator new since the program started
+uint64_t GetAllocationCount();
+
+}  // namespace HeapStats
+
+}  // namespace Gauge
\ No newline at end of file
@@ -0,0 +1,254 @@
+#include "job_system.hpp"
+
+#include <format>
+#include <string>
+
+#include "thirdparty/tracy/public/common/TracySystem.hpp"
+
+using namespace Gauge;
+
+namespace {
+// Index of the queue owned by the current thread, -1 for non-worker threads
+thread_local int worker_index = -1;
+thread_local uint steal_seed = 0;
+}  // namespace
+
+void JobSystem::WorkQueue::PushBack(Job p_job) {
+    if (count == jobs.size()) {
+        // Sizes stay powers of two so indices can wrap with a mask
+        std::vector<Job> grown(std::max<size_t>(jobs.size() * 2, 64));
+        for (uint i = 0; i < count; ++i) {
+            grown[i] = std::move(jobs[(head + i) & (jobs.size() - 1)]);
+        }
+        jobs = std::move(grown);
+        head = 0;
+    }
+    jobs[(head + count) & (jobs.size() - 1)] = std::move(p_job);
+    count++;
+}
+
+JobSystem::Job JobSystem::WorkQueue::PopBack() {
+    count--;
+    return std::move(jobs[(head + count) & (jobs.size() - 1)]);
+}
+
+JobSystem::Job JobSystem::WorkQueue::PopFront() {
+    Job job = std::move(jobs[head]);
+    head = (head + 1) & (jobs.size() - 1);
+    count--;
+    return job;
+}
+
+JobSystem& JobSystem::Get() {
+    // The main thread helps out while waiting, so it does not need a worker
+    static JobSystem job_system(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+    return job_system;
+}
+
+JobSystem::JobSystem(uint p_thread_count) {
+    queues.reserve(p_thread_count + 1);
+    for (uint i = 0; i < p_thread_count + 1; ++i) {
+        queues.emplace_back(std::make_unique<WorkQueue>());
+    }
+
+    max_background_jobs = std::max(p_thread_count, 2u) - 1;
+    threads.reserve(p_thread_count);
+    for (uint i = 0; i < p_thread_count; ++i) {
+        threads.emplace_back([this, i](std::stop_token p_stop_token) {
+            WorkerMain(p_stop_token, i);
+        });
+    }
+}
+
+JobSystem::~JobSystem() {
+    for (auto& thread : threads) {
+        thread.request_stop();
+    }
+    wake_condition.notify_all();
+    // Threads are joined by the jthread destructors
+}
+
+void JobSystem::WorkerMain(std::stop_token p_stop_token, uint p_index) {
+    worker_index = p_index;
+    steal_seed = p_index;
+    const std::string name = std::format("Job Worker {}", p_index);
+    tracy::SetThreadName(name.c_str());
+
+    while (!p_stop_token.stop_requested()) {
+        if (RunPendingJob() || RunBackgroundJob()) {
+            continue;
+        }
+        std::unique_lock lock(sleep_mutex);
+        wake_condition.wait(lock, p_stop_token, [this] {
+            return queued_jobs.load(std::memory_order_acquire) > 0 || CanRunBackgroundJob();
+        });
+    }
+}
+
+void JobSystem::Push(Job p_job) {
+    const uint queue_index = worker_index >= 0 ? uint(worker_index) : queues.size() - 1;
+    WorkQueue& queue = *queues[queue_index];
+    {
+        std::lock_guard lock(queue.mutex);
+        queue.PushBack(std::move(p_job));
+    }
+    {
+        // Pairs with the predicate check in WorkerMain so a wakeup can not be missed
+        std::lock_guard lock(sleep_mutex);
+        queued_jobs.fetch_add(1, std::memory_order_release);
+    }
+    wake_condition.notify_one();
+}
+
+bool JobSystem::TryPop(Job& r_job) {
+    // Own queue first, newest job first to keep caches warm
+    if (worker_index >= 0) {
+        WorkQueue& queue = *queues[worker_index];
+        std::lock_guard lock(queue.mutex);
+        if (!queue.IsEmpty()) {
+            r_job = queue.PopBack();
+            return true;
+        }
+    }
+
+    // Steal the oldest job from another queue, starting at a varying victim
+    const uint queue_count = queues.size();
+    steal_seed = steal_seed * 1664525u + 1013904223u;
+    const uint start = steal_seed % queue_count;
+    for (uint i = 0; i < queue_count; ++i) {
+        const uint victim = (start + i) % queue_count;
+        if (int(victim) == worker_index) {
+            continue;
+        }
+        WorkQueue& queue = *queues[victim];
+        std::lock_guard lock(queue.mutex);
+        if (!queue.IsEmpty()) {
+            r_job = queue.PopFront();
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::Execute(Job& p_job) {
+    queued_jobs.fetch_sub(1, std::memory_order_relaxed);
+    p_job.function();
+
+    JobCounter* counter = p_job.counter;
+    if (counter == nullptr) {
+        return;
+    }
+
+    // The decrement happens under the lock, and Wait takes the lock before
+    // returning, so a waiter can not destroy the counter while it is in use here
+    std::vector<JobCounter::Continuation> continuations;
+    {
+        std::lock_guard lock(counter->mutex);
+        if (counter->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            continuations.swap(counter->continuations);
+        }
+    }
+    for (auto& continuation : continuations) {
+        Push(Job{
+            .function = std::move(continuation.function),
+            .counter = continuation.counter,
+        });
+    }
+}
+
+bool JobSystem::RunPendingJob() {
+    if (queued_jobs.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+    Job job;
+    if (!TryPop(job)) {
+        return false;
+    }
+    Execute(job);
+    return true;
+}
+
+bool JobSystem::CanRunBackgroundJob() const {
+    return queued_background_jobs.load(std::memory_order_acquire) > 0 &&
+           running_background_jobs.load(std::memory_order_acquire) < max_background_jobs;
+}
+
+bool JobSystem::RunBackgroundJob() {
+    if (!CanRunBackgroundJob()) {
+        return false;
+    }
+    // Claims a slot first so that concurrent callers can not exceed the limit
+    if (running_background_jobs.fetch_add(1, std::memory_order_acq_rel) >= max_background_jobs) {
+        running_background_jobs.fetch_sub(1, std::memory_order_acq_rel);
+        return false;
+    }
+
+    JobFunction function;
+    {
+        std::lock_guard lock(background_queue.mutex);
+        if (!background_queue.IsEmpty()) {
+            function = std::move(background_queue.PopFront().function);
+        }
+    }
+    if (function) {
+        queued_background_jobs.fetch_sub(1, std::memory_order_relaxed);
+        function();
+    }
+
+    {
+        // A worker may have gone to sleep while the limit was reached
+        std::lock_guard lock(sleep_mutex);
+        running_background_jobs.fetch_sub(1, std::memory_order_release);
+    }
+    if (queued_background_jobs.load(std::memory_order_acquire) > 0) {
+        wake_condition.notify_one();
+    }
+    return function != nullptr;
+}
+
+void JobSystem::SubmitBackground(JobFunction p_function) {
+    {
+        std::lock_guard lock(background_queue.mutex);
+        background_queue.PushBack(Job{
+            .function = std::move(p_function),
+            .counter = nullptr,
+        });
+    }
+    {
+        std::lock_guard lock(sleep_mutex);
+        queued_background_jobs.fetch_add(1, std::memory_order_release);
+    }
+    wake_condition.notify_one();
+}
+
+void JobSystem::Submit(JobFunction p_function, JobCounter* p_counter, JobCounter* p_dependency) {
+    if (p_counter != nullptr) {
+        p_counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (p_dependency != nullptr) {
+        std::lock_guard lock(p_dependency->mutex);
+        if (!p_dependency->IsDone()) {
+            p_dependency->continuations.push_back(JobCounter::Continuation{
+                .function = std::move(p_function),
+                .counter = p_counter,
+            });
+            return;
+        }
+    }
+
+    Push(Job{
+        .function = std::move(p_function),
+        .counter = p_counter,
+    });
+}
+
+void JobSystem::Wait(JobCounter& p_counter) {
+    while (!p_counter.IsDone()) {
+        if (!RunPendingJob()) {
+            std::this_thread::yield();
+        }
+    }
+    // Wait for the job that finished last to release the counter
+    std::lock_guard lock(p_counter.mutex);
+}
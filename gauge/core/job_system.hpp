@@ -0,0 +1,144 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Gauge {
+
+// Tracks a group of jobs. The counter holds the number of unfinished jobs
+// submitted with it; jobs submitted with it as a dependency are started
+// once it drops to zero. Call JobSystem::Wait before destroying a counter
+// that jobs were submitted with.
+class JobCounter {
+    friend class JobSystem;
+
+    struct Continuation {
+        std::function<void()> function;
+        JobCounter* counter;
+    };
+
+    std::atomic<uint> pending = 0;
+    std::mutex mutex;
+    std::vector<Continuation> continuations;
+
+   public:
+    bool IsDone() const { return pending.load(std::memory_order_acquire) == 0; }
+    uint GetPending() const { return pending.load(std::memory_order_acquire); }
+};
+
+// Engine-wide job system. Every worker owns a deque it pushes to and pops
+// from at the back, idle workers steal from the front of other deques.
+// Threads that are not workers submit into a shared deque. Waiting threads
+// execute jobs instead of blocking, so waiting on a job from inside a job
+// is allowed. Background jobs have a queue of their own that only idle
+// workers take from, so a long running load never ends up on a thread
+// that waits for frame work.
+class JobSystem {
+   public:
+    using JobFunction = std::function<void()>;
+
+   private:
+    struct Job {
+        JobFunction function;
+        JobCounter* counter;
+    };
+
+    // Ring buffer that only ever grows. Unlike a deque, which allocates
+    // blocks as jobs move through it, steady-state use does not allocate.
+    struct WorkQueue {
+        std::mutex mutex;
+        std::vector<Job> jobs;
+        uint head = 0;
+        uint count = 0;
+
+        bool IsEmpty() const { return count == 0; }
+        void PushBack(Job p_job);
+        Job PopBack();
+        Job PopFront();
+    };
+
+    std::vector<std::jthread> threads;
+    // One queue per worker, the last one is shared by all other threads
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    WorkQueue background_queue;
+    std::atomic<uint> queued_jobs = 0;
+    std::atomic<uint> queued_background_jobs = 0;
+    // Background jobs leave at least one worker free for frame work
+    std::atomic<uint> running_background_jobs = 0;
+    uint max_background_jobs = 1;
+    std::mutex sleep_mutex;
+    std::condition_variable_any wake_condition;
+
+    void WorkerMain(std::stop_token p_stop_token, uint p_index);
+    void Push(Job p_job);
+    bool TryPop(Job& r_job);
+    void Execute(Job& p_job);
+    bool CanRunBackgroundJob() const;
+
+   public:
+    // Runs p_function on a worker. If p_counter is given it is incremented
+    // now and decremented when the job has finished. If p_dependency is given
+    // the job is held back until that counter reaches zero.
+    void Submit(JobFunction p_function, JobCounter* p_counter = nullptr, JobCounter* p_dependency = nullptr);
+    // Executes jobs until p_counter reaches zero
+    void Wait(JobCounter& p_counter);
+    // Executes a single pending job if there is one. Never runs background jobs.
+    bool RunPendingJob();
+
+    // Runs p_function on a worker that has nothing else to do, for work that
+    // takes long and nobody waits on within a frame, like loading assets
+    void SubmitBackground(JobFunction p_function);
+    // Executes a single background job if there is one and the limit of
+    // concurrently running background jobs allows it
+    bool RunBackgroundJob();
+
+    // Calls p_function(index) for every index in [0, p_count), in batches
+    // of p_batch_size indices. Returns once all batches have finished.
+    template <typename F>
+    void ParallelFor(uint p_count, uint p_batch_size, F&& p_function);
+
+    uint GetThreadCount() const { return threads.size(); }
+
+    // Shared job system, created on first use
+    static JobSystem& Get();
+
+    JobSystem(uint p_thread_count);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+};
+
+template <typename F>
+void JobSystem::ParallelFor(uint p_count, uint p_batch_size, F&& p_function) {
+    if (p_count == 0) {
+        return;
+    }
+    if (p_batch_size == 0) {
+        p_batch_size = 1;
+    }
+
+    auto run_batch = [&p_function, p_count, p_batch_size](uint p_batch) {
+        const uint begin = p_batch * p_batch_size;
+        const uint end = std::min(begin + p_batch_size, p_count);
+        for (uint index = begin; index < end; ++index) {
+            p_function(index);
+        }
+    };
+
+    const uint batch_count = (p_count + p_batch_size - 1) / p_batch_size;
+    JobCounter counter;
+    for (uint batch = 1; batch < batch_count; ++batch) {
+        Submit([&run_batch, batch]() { run_batch(batch); }, &counter);
+    }
+    run_batch(0);
+    Wait(counter);
+}
+
+}  // namespace Gauge
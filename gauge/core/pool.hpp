@@ -2,77 +2,155 @@
 
 #include "handle.hpp"
 
-#include <queue>
+#include <cstdlib>
+#include <memory>
+#include <print>
+#include <utility>
 #include <vector>
 
 namespace Gauge {
 
-template <typename T>
+// Generational object pool. Elements live in fixed-size chunks that are never
+// moved, so pointers returned by Get stay valid until the element is freed.
+// Freed slots are chained into an intrusive LIFO free list.
+template <typename T, uint CHUNK_SIZE = 1024>
 struct Pool {
-    std::vector<T> data;
-    std::vector<uint16_t> generations;
-    std::queue<uint16_t> free_list;
+    static_assert((CHUNK_SIZE & (CHUNK_SIZE - 1)) == 0, "Pool chunk size must be a power of two");
+    static constexpr uint INVALID_INDEX = ~0u;
+
+    struct Slot {
+        union {
+            T value;
+            uint next_free;
+        };
+        uint generation = 0;
+
+        Slot() : next_free(INVALID_INDEX) {}
+        ~Slot() {}
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> chunks;
+    uint used_slots = 0;
+    uint live_count = 0;
+    uint free_head = INVALID_INDEX;
 
     Handle<T> Allocate(T p_data);
     T* Get(Handle<T> p_handle);
-    T* Get(uint p_handle);
+    T* Get(uint64_t p_handle);
     void Free(Handle<T> p_handle);
-    void Free(uint p_handle);
+    void Free(uint64_t p_handle);
+    // For users that only kept the index of an element
+    void FreeAt(uint p_index);
+
+    uint Count() const { return live_count; }
+    uint Capacity() const { return chunks.size() * CHUNK_SIZE; }
 
     Pool(uint p_initial_size = 2048);
+    ~Pool();
+
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+   private:
+    Slot& GetSlot(uint p_index) {
+        return chunks[p_index / CHUNK_SIZE][p_index & (CHUNK_SIZE - 1)];
+    }
 };
 
-template <typename T>
-Pool<T>::Pool(uint p_initial_size) {
-    data.resize(p_initial_size);
-    generations.resize(p_initial_size);
-    for (uint i = 0; i < p_initial_size - 1; ++i) {
-        free_list.push(i);
+template <typename T, uint CHUNK_SIZE>
+Pool<T, CHUNK_SIZE>::Pool(uint p_initial_size) {
+    const uint chunk_count = (p_initial_size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    chunks.reserve(chunk_count);
+    for (uint i = 0; i < chunk_count; ++i) {
+        chunks.emplace_back(std::make_unique<Slot[]>(CHUNK_SIZE));
+    }
+}
+
+template <typename T, uint CHUNK_SIZE>
+Pool<T, CHUNK_SIZE>::~Pool() {
+    // Free slots are marked with an odd generation, see Free()
+    for (uint i = 0; i < used_slots; ++i) {
+        Slot& slot = GetSlot(i);
+        if ((slot.generation & 1) == 0) {
+            std::destroy_at(&slot.value);
+        }
     }
 }
 
-template <typename T>
-Handle<T> Pool<T>::Allocate(T p_data) {
-    if (free_list.empty()) [[unlikely]] {
-        uint new_size = 2 * data.size();
-        data.resize(new_size);
-        generations.resize(new_size);
-        for (uint i = new_size - 1; i >= (new_size / 2); --i) {
-            free_list.push(i);
+template <typename T, uint CHUNK_SIZE>
+Handle<T> Pool<T, CHUNK_SIZE>::Allocate(T p_data) {
+    uint index;
+    if (free_head != INVALID_INDEX) {
+        index = free_head;
+        free_head = GetSlot(index).next_free;
+    } else {
+        if (used_slots == Handle<T>::MAX_INDEX) [[unlikely]] {
+            // Wrapping around would alias live handles
+            std::println("Gauge Error: Pool ran out of handle indices");
+            std::abort();
+        }
+        if (used_slots == Capacity()) [[unlikely]] {
+            chunks.emplace_back(std::make_unique<Slot[]>(CHUNK_SIZE));
         }
+        index = used_slots++;
     }
-    uint16_t index = free_list.front();
-    data[index] = p_data;
-    free_list.pop();
+
+    Slot& slot = GetSlot(index);
+    // Bring the generation back to an even (live) value
+    slot.generation = (slot.generation + (slot.generation & 1)) & Handle<T>::MAX_GENERATION;
+    std::construct_at(&slot.value, std::move(p_data));
+    live_count++;
     return {
         .index = index,
-        .generation = generations[index],
+        .generation = slot.generation,
     };
 }
 
-template <typename T>
-T* Pool<T>::Get(Handle<T> p_handle) {
-    if (p_handle.generation != generations[p_handle.index]) {
+template <typename T, uint CHUNK_SIZE>
+T* Pool<T, CHUNK_SIZE>::Get(Handle<T> p_handle) {
+    if (p_handle.index >= used_slots) [[unlikely]] {
+        return nullptr;
+    }
+    Slot& slot = GetSlot(p_handle.index);
+    if (p_handle.generation != slot.generation) {
         return nullptr;
     }
 
-    return &data[p_handle.index];
+    return &slot.value;
 }
 
-template <typename T>
-T* Pool<T>::Get(uint p_handle) {
+template <typename T, uint CHUNK_SIZE>
+T* Pool<T, CHUNK_SIZE>::Get(uint64_t p_handle) {
     return Get(Handle<T>::FromUint(p_handle));
 }
 
-template <typename T>
-void Pool<T>::Free(Handle<T> p_handle) {
-    generations[p_handle.index]++;
-    free_list.push(p_handle.index);
+template <typename T, uint CHUNK_SIZE>
+void Pool<T, CHUNK_SIZE>::Free(Handle<T> p_handle) {
+    if (Get(p_handle) == nullptr) [[unlikely]] {
+        return;
+    }
+    Slot& slot = GetSlot(p_handle.index);
+    std::destroy_at(&slot.value);
+    slot.generation = (slot.generation + 1) & Handle<T>::MAX_GENERATION;
+    slot.next_free = free_head;
+    free_head = p_handle.index;
+    live_count--;
 }
 
-template <typename T>
-void Pool<T>::Free(uint p_handle) {
+template <typename T, uint CHUNK_SIZE>
+void Pool<T, CHUNK_SIZE>::Free(uint64_t p_handle) {
     Free(Handle<T>::FromUint(p_handle));
 }
 
+template <typename T, uint CHUNK_SIZE>
+void Pool<T, CHUNK_SIZE>::FreeAt(uint p_index) {
+    if (p_index >= used_slots || (GetSlot(p_index).generation & 1) != 0) [[unlikely]] {
+        return;
+    }
+    Free(Handle<T>{
+        .index = p_index,
+        .generation = GetSlot(p_index).generation,
+    });
+}
+
 }  // namespace Gauge
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+namespace Gauge {
+
+// Sorts r_values by r_keys, both in place, least significant byte first. The
+// sort is stable. Bytes that are the same in every key are skipped, which is
+// common for keys with unused or constant fields. The scratch spans need to
+// be at least as large as the input.
+template <typename T>
+void RadixSort(std::span<uint64_t> r_keys, std::span<T> r_values, std::span<uint64_t> p_scratch_keys, std::span<T> p_scratch_values) {
+    const size_t count = r_keys.size();
+    std::array<std::array<uint32_t, 256>, 8> histograms{};
+    for (const uint64_t key : r_keys) {
+        for (uint byte = 0; byte < 8; ++byte) {
+            histograms[byte][(key >> (byte * 8)) & 0xff]++;
+        }
+    }
+
+    uint64_t* keys = r_keys.data();
+    T* values = r_values.data();
+    uint64_t* scratch_keys = p_scratch_keys.data();
+    T* scratch_values = p_scratch_values.data();
+    for (uint byte = 0; byte < 8; ++byte) {
+        std::array<uint32_t, 256>& histogram = histograms[byte];
+        if (count == 0 || histogram[(keys[0] >> (byte * 8)) & 0xff] == count) {
+            continue;
+        }
+        uint32_t offset = 0;
+        for (uint32_t& bucket : histogram) {
+            offset += std::exchange(bucket, offset);
+        }
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t index = histogram[(keys[i] >> (byte * 8)) & 0xff]++;
+            scratch_keys[index] = keys[i];
+            scratch_values[index] = values[i];
+        }
+        std::swap(keys, scratch_keys);
+        std::swap(values, scratch_values);
+    }
+
+    if (keys != r_keys.data()) {
+        std::copy_n(keys, count, r_keys.data());
+        std::copy_n(values, count, r_values.data());
+    }
+}
+
+}  // namespace Gauge
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "range_allocator.hpp"
+
+#include <cassert>
+#include <iterator>
+
+using namespace Gauge;
+
+void RangeAllocator::Insert(uint64_t p_offset, uint64_t p_size) {
+    free_by_offset.emplace(p_offset, p_size);
+    free_by_size.emplace(p_size, p_offset);
+}
+
+void RangeAllocator::Erase(std::map<uint64_t, uint64_t>::iterator p_range) {
+    auto [first, last] = free_by_size.equal_range(p_range->second);
+    for (auto it = first; it != last; ++it) {
+        if (it->second == p_range->first) {
+            free_by_size.erase(it);
+            break;
+        }
+    }
+    free_by_offset.erase(p_range);
+}
+
+uint64_t RangeAllocator::Allocate(uint64_t p_size, uint64_t p_alignment) {
+    assert((p_alignment & (p_alignment - 1)) == 0);
+    if (p_size == 0) {
+        return INVALID_OFFSET;
+    }
+
+    // Smallest range that still fits once its start is aligned
+    for (auto it = free_by_size.lower_bound(p_size); it != free_by_size.end(); ++it) {
+        const uint64_t range_offset = it->second;
+        const uint64_t range_size = it->first;
+        const uint64_t offset = (range_offset + p_alignment - 1) & ~(p_alignment - 1);
+        const uint64_t padding = offset - range_offset;
+        if (padding + p_size > range_size) {
+            continue;
+        }
+
+        Erase(free_by_offset.find(range_offset));
+        if (padding > 0) {
+            Insert(range_offset, padding);
+        }
+        if (padding + p_size < range_size) {
+            Insert(offset + p_size, range_size - padding - p_size);
+        }
+        used += p_size;
+        return offset;
+    }
+    return INVALID_OFFSET;
+}
+
+void RangeAllocator::Free(uint64_t p_offset, uint64_t p_size) {
+    if (p_size == 0) {
+        return;
+    }
+    assert(p_offset + p_size <= capacity && used >= p_size);
+    used -= p_size;
+
+    uint64_t offset = p_offset;
+    uint64_t size = p_size;
+    auto next = free_by_offset.lower_bound(p_offset);
+    if (next != free_by_offset.begin()) {
+        auto previous = std::prev(next);
+        assert(previous->first + previous->second <= p_offset);
+        if (previous->first + previous->second == p_offset) {
+            offset = previous->first;
+            size += previous->second;
+            Erase(previous);
+        }
+    }
+    if (next != free_by_offset.end()) {
+        assert(p_offset + p_size <= next->first);
+        if (p_offset + p_size == next->first) {
+            size += next->second;
+            Erase(next);
+        }
+    }
+    Insert(offset, size);
+}
+
+void RangeAllocator::Grow(uint64_t p_capacity) {
+    if (p_capacity <= capacity) {
+        return;
+    }
+    const uint64_t old_capacity = capacity;
+    capacity = p_capacity;
+    // Merges with a free range at the end, if there is one
+    used += p_capacity - old_capacity;
+    Free(old_capacity, p_capacity - old_capacity);
+}
\ No newline at end of file
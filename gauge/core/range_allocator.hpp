@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace Gauge {
+
+// Sub-allocates ranges of an address space that lives elsewhere, e.g. a GPU
+// buffer. Free ranges are kept by offset, to merge them with their
+// neighbours when freed, and by size, to pick the smallest one that fits.
+// Allocating and freeing are O(log n) in the number of free ranges.
+class RangeAllocator {
+    std::map<uint64_t, uint64_t> free_by_offset;
+    std::multimap<uint64_t, uint64_t> free_by_size;
+    uint64_t capacity = 0;
+    uint64_t used = 0;
+
+    void Insert(uint64_t p_offset, uint64_t p_size);
+    void Erase(std::map<uint64_t, uint64_t>::iterator p_range);
+
+   public:
+    static constexpr uint64_t INVALID_OFFSET = ~0ull;
+
+    // Returns INVALID_OFFSET if no free range fits the size. The alignment
+    // must be a power of two.
+    uint64_t Allocate(uint64_t p_size, uint64_t p_alignment = 1);
+    // Takes the offset and size of an allocation
+    void Free(uint64_t p_offset, uint64_t p_size);
+    // Appends free space up to the new capacity
+    void Grow(uint64_t p_capacity);
+
+    uint64_t GetCapacity() const { return capacity; }
+    uint64_t GetUsed() const { return used; }
+    uint64_t GetLargestFree() const { return free_by_size.empty() ? 0 : free_by_size.rbegin()->first; }
+    size_t GetFreeRangeCount() const { return free_by_offset.size(); }
+};
+
+}  // namespace Gauge
\ No newline at end of file
@@ -1,10 +1,22 @@
 #pragma once
 
 #include <gauge/common.hpp>
+#include <gauge/core/job_system.hpp>
 #include <gauge/core/pool.hpp>
 #include <gauge/core/string_id.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <print>
+#include <thread>
+#include <vector>
 
 namespace Gauge {
 
@@ -14,6 +26,15 @@ concept IsResource = requires(R resource, StringID p_id, Ts... p_arguments) {
     resource.Unload();
 };
 
+// Resources that can be loaded in two steps: Prepare does the CPU work
+// (file IO, parsing, decoding) and must be safe to run on a worker thread,
+// Upload creates GPU objects and is always called on the render thread.
+template <typename R>
+concept IsAsyncResource = IsResource<R> && requires(R resource, StringID p_id) {
+    { R::Prepare(p_id) } -> std::same_as<Result<R>>;
+    { resource.Upload() } -> std::same_as<Result<>>;
+};
+
 class ResourceManager {
    public:
     enum LoadStatus {
@@ -25,30 +46,252 @@ class ResourceManager {
     enum Usage {
         UNLOAD_WHEN_UNUSED,
         KEEP_LOADED,
+        // Unused resources stay loaded until the cache budget of their type is exceeded,
+        // then the least recently used ones are unloaded first
+        CACHE_WHEN_UNUSED,
+    };
+
+    struct CacheStats {
+        // Requests for a resource that was parked in the cache
+        uint64_t hits = 0;
+        // Requests that had to load the resource
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t cached_bytes = 0;
+        size_t budget = 0;
     };
 
    private:
     template <IsResource R>
     inline static Pool<R> pool;
 
+    // State of one LoadAsync request, shared between the worker, the
+    // resource entry and every Future handed out for it
+    template <IsResource R>
+    struct PendingLoad {
+        StringID id;
+        // Written by the worker before prepared is set
+        std::optional<Result<R>> result;
+        std::atomic<bool> prepared = false;
+        // Only accessed on the render thread
+        LoadStatus status = LOADING;
+        R* resource{};
+    };
+
     template <IsResource R>
     struct ResourceInfo {
         Handle<R> handle{};
         uint reference_count = 0;
         LoadStatus status = UNLOADED;
         Usage usage = UNLOAD_WHEN_UNUSED;
+        std::shared_ptr<PendingLoad<R>> pending;
+        // Set while the resource is unused and parked in the cache
+        std::optional<std::list<StringID>::iterator> cache_position;
+        size_t size = 0;
+    };
+
+    template <IsResource R>
+    struct Cache {
+        // Most recently released resources first
+        std::list<StringID> lru;
+        Usage default_usage = UNLOAD_WHEN_UNUSED;
+        CacheStats stats{
+            .budget = 256 * 1024 * 1024,
+        };
     };
 
     template <IsResource R>
     inline static StringID::Map<ResourceInfo<R>> resources;
 
+    // Guards pool<R> and resources<R>. Recursive because unloading a resource
+    // may unreference others of the same type.
+    template <IsResource R>
+    inline static std::recursive_mutex mutex;
+
+    template <IsResource R>
+    inline static Cache<R> cache;
+
+    inline static std::mutex upload_mutex;
+    // GPU parts of loads, in the order their CPU parts finished. Return false
+    // if the load can't be finished yet.
+    inline static std::deque<std::function<bool()>> uploads;
+    inline static std::chrono::microseconds upload_budget{2000};
+
+    // Resources can hold their upload back until resources they depend on
+    // are loaded, so finishing them never has to wait
+    template <IsAsyncResource R>
+    static bool IsReadyToUpload(const PendingLoad<R>& p_pending) {
+        if constexpr (requires(const R& p_resource) { { p_resource.IsReadyToUpload() } -> std::same_as<bool>; }) {
+            if (p_pending.status != LOADING || !p_pending.result.value()) {
+                return true;
+            }
+            return p_pending.result.value()->IsReadyToUpload();
+        }
+        return true;
+    }
+
+    template <IsAsyncResource R>
+    static void FinishLoad(const std::shared_ptr<PendingLoad<R>>& p_pending) {
+        std::lock_guard lock(mutex<R>);
+        if (p_pending->status != LOADING) {
+            return;
+        }
+
+        Result<R>& result = p_pending->result.value();
+        if (result) {
+            auto upload_result = result->Upload();
+            if (!upload_result) {
+                result = Error(upload_result.error());
+            }
+        }
+
+        auto& info = resources<R>[p_pending->id];
+        if (!result) {
+            std::println("Could not load {}: {}", p_pending->id, result.error());
+            p_pending->status = UNLOADED;
+            resources<R>.erase(p_pending->id);
+            return;
+        }
+
+        info.handle = pool<R>.Allocate(std::move(result.value()));
+        info.size = GetSize(*pool<R>.Get(info.handle));
+        info.status = LOADED;
+        info.pending = nullptr;
+        p_pending->result.reset();
+        p_pending->resource = pool<R>.Get(info.handle);
+        p_pending->status = LOADED;
+        std::println("Finished loading {}", p_pending->id);
+
+        if (info.reference_count == 0) {
+            // Everyone lost interest while the resource was loading
+            if (info.usage == UNLOAD_WHEN_UNUSED) {
+                p_pending->resource = nullptr;
+                p_pending->status = UNLOADED;
+            }
+            Release<R>(p_pending->id, info);
+        }
+    }
+
+    template <IsResource R>
+    static size_t GetSize(const R& p_resource) {
+        if constexpr (requires { { p_resource.GetSize() } -> std::convertible_to<size_t>; }) {
+            return p_resource.GetSize();
+        } else {
+            return sizeof(R);
+        }
+    }
+
+    // Called once the reference count of a loaded resource dropped to zero
+    template <IsResource R>
+    static void Release(StringID p_id, ResourceInfo<R>& p_info) {
+        switch (p_info.usage) {
+            case KEEP_LOADED:
+                std::println("Keeping {} loaded", p_id);
+                return;
+            case UNLOAD_WHEN_UNUSED:
+                Unload<R>(p_id, p_info);
+                return;
+            case CACHE_WHEN_UNUSED:
+                std::println("Caching {}", p_id);
+                cache<R>.lru.push_front(p_id);
+                p_info.cache_position = cache<R>.lru.begin();
+                cache<R>.stats.cached_bytes += p_info.size;
+                Evict<R>();
+                return;
+        }
+    }
+
+    // Unloads cached resources, least recently used first, until the cache fits its budget
+    template <IsResource R>
+    static void Evict() {
+        Cache<R>& type_cache = cache<R>;
+        while (type_cache.stats.cached_bytes > type_cache.stats.budget && !type_cache.lru.empty()) {
+            const StringID id = type_cache.lru.back();
+            auto& info = resources<R>[id];
+            type_cache.lru.pop_back();
+            type_cache.stats.cached_bytes -= info.size;
+            type_cache.stats.evictions++;
+            info.cache_position.reset();
+            std::println("Evicting {} from cache", id);
+            Unload<R>(id, info);
+        }
+    }
+
+    template <IsResource R>
+    static void Unload(StringID p_id, ResourceInfo<R>& p_info) {
+        std::println("Unloading {}", p_id);
+        R* resource = pool<R>.Get(p_info.handle);
+        resource->Unload();
+        pool<R>.Free(p_info.handle);
+        resources<R>.erase(p_id);
+    }
+
    public:
+    // Result of LoadAsync. Polling and waiting must happen on the render thread,
+    // which is where the GPU part of a load is executed.
+    template <IsAsyncResource R>
+    class Future {
+        std::shared_ptr<PendingLoad<R>> pending;
+
+       public:
+        bool IsValid() const {
+            return pending != nullptr;
+        }
+
+        // True once the load either finished or failed
+        bool IsReady() const {
+            return pending != nullptr && pending->status != LOADING;
+        }
+
+        LoadStatus GetStatus() const {
+            return pending != nullptr ? pending->status : UNLOADED;
+        }
+
+        // Only valid futures have an ID
+        StringID GetID() const {
+            return pending->id;
+        }
+
+        // Returns nullptr while loading or if loading failed
+        R* Get() const {
+            return pending != nullptr ? pending->resource : nullptr;
+        }
+
+        // Runs jobs until the CPU part is done and finishes the load right away
+        R* Wait() const {
+            if (pending == nullptr) {
+                return nullptr;
+            }
+            if (pending->status == LOADING) {
+                while (!pending->prepared.load()) {
+                    // The load is a background job, help out with those as well
+                    if (!JobSystem::Get().RunPendingJob() && !JobSystem::Get().RunBackgroundJob()) {
+                        std::this_thread::yield();
+                    }
+                }
+                FinishLoad<R>(pending);
+            }
+            return pending->resource;
+        }
+
+        Future() = default;
+        Future(std::shared_ptr<PendingLoad<R>> p_pending) : pending(std::move(p_pending)) {}
+    };
+
     template <IsResource R, typename... Ts>
     static R* Load(StringID p_id, Ts... p_arguments) {
+        std::unique_lock lock(mutex<R>);
         if (resources<R>.contains(p_id)) {
             std::println("Resource {} is already loaded", p_id);
             ResourceManager::Reference<R>(p_id);
             auto& info = resources<R>[p_id];
+            if constexpr (IsAsyncResource<R>) {
+                if (info.status == LOADING) {
+                    Future<R> future(info.pending);
+                    lock.unlock();
+                    return future.Wait();
+                }
+            }
             return pool<R>.Get(info.handle);
         }
 
@@ -58,23 +301,118 @@ class ResourceManager {
         resources<R>[p_id] = ResourceInfo<R>{
             .handle = handle,
             .reference_count = 1,
-            .status = LOADED};
+            .status = LOADED,
+            .usage = cache<R>.default_usage,
+            .size = GetSize(resource)};
+        cache<R>.stats.misses++;
         return pool<R>.Get(handle);
     }
 
+    // Starts loading a resource as a job and returns immediately.
+    // Requests for a resource that is already loading share the same load.
+    // Like Load, every call adds a reference. Can be called from any thread.
+    template <IsAsyncResource R>
+    static Future<R> LoadAsync(StringID p_id) {
+        std::lock_guard lock(mutex<R>);
+        if (resources<R>.contains(p_id)) {
+            ResourceManager::Reference<R>(p_id);
+            auto& info = resources<R>[p_id];
+            if (info.status == LOADING) {
+                return Future<R>(info.pending);
+            }
+            auto loaded = std::make_shared<PendingLoad<R>>();
+            loaded->id = p_id;
+            loaded->status = LOADED;
+            loaded->resource = pool<R>.Get(info.handle);
+            return Future<R>(loaded);
+        }
+
+        std::println("Loading {} asynchronously", p_id);
+        auto pending = std::make_shared<PendingLoad<R>>();
+        pending->id = p_id;
+        resources<R>[p_id] = ResourceInfo<R>{
+            .reference_count = 1,
+            .status = LOADING,
+            .usage = cache<R>.default_usage,
+            .pending = pending};
+        cache<R>.stats.misses++;
+
+        JobSystem::Get().SubmitBackground([pending]() {
+            pending->result = R::Prepare(pending->id);
+            pending->prepared = true;
+
+            std::lock_guard lock(upload_mutex);
+            uploads.emplace_back([pending]() {
+                if (!IsReadyToUpload<R>(*pending)) {
+                    return false;
+                }
+                FinishLoad<R>(pending);
+                return true;
+            });
+        });
+        return Future<R>(pending);
+    }
+
+    // Runs the GPU part of loads whose CPU part has finished, oldest first,
+    // until the upload budget is used up. At least one load is finished per
+    // call so uploading always makes progress. Called by the renderer once
+    // per frame while it records uploads into the frame.
+    static void ProcessUploads() {
+        const auto start = std::chrono::steady_clock::now();
+        size_t remaining;
+        std::chrono::microseconds budget;
+        {
+            std::lock_guard lock(upload_mutex);
+            remaining = uploads.size();
+            budget = upload_budget;
+        }
+        // Loads that are held back go to the back, so each is tried once per call
+        bool finished_any = false;
+        for (; remaining > 0; --remaining) {
+            if (finished_any && std::chrono::steady_clock::now() - start >= budget) {
+                break;
+            }
+            std::function<bool()> upload;
+            {
+                std::lock_guard lock(upload_mutex);
+                upload = std::move(uploads.front());
+                uploads.pop_front();
+            }
+            if (upload()) {
+                finished_any = true;
+                continue;
+            }
+            std::lock_guard lock(upload_mutex);
+            uploads.push_back(std::move(upload));
+        }
+    }
+
+    static void SetUploadBudget(std::chrono::microseconds p_budget) {
+        std::lock_guard lock(upload_mutex);
+        upload_budget = p_budget;
+    }
+
     template <IsResource R>
     static void Reference(StringID p_id) {
+        std::lock_guard lock(mutex<R>);
         if (!resources<R>.contains(p_id)) {
             std::println("Can not reference {}, resource is not loaded", p_id);
             return;
         }
         auto& info = resources<R>[p_id];
+        if (info.cache_position.has_value()) {
+            cache<R>.lru.erase(info.cache_position.value());
+            cache<R>.stats.cached_bytes -= info.size;
+            cache<R>.stats.hits++;
+            info.cache_position.reset();
+        }
         info.reference_count++;
         std::println("Referencing {}: {} [+1]", p_id, info.reference_count);
     }
 
     template <IsResource R>
     static void Unreference(StringID p_id) {
+        std::lock_guard lock(mutex<R>);
         if (!resources<R>.contains(p_id)) {
             std::println("Can not dereference {}, resource is not loaded", p_id);
             return;
@@ -86,18 +424,50 @@ class ResourceManager {
         }
         info.reference_count = 0;
         std::println("Dereferencing {}: {} [-1]", p_id, info.reference_count);
-        if (info.usage == KEEP_LOADED) {
-            std::println("Keeping {} loaded", p_id);
+        if (info.status == LOADING) {
+            // Handled once the load finishes
             return;
-        } else if (info.usage == UNLOAD_WHEN_UNUSED) {
-            std::println("Unloading {}", p_id);
-            R* resource = pool<R>.Get(info.handle);
-            resource->Unload();
-            pool<R>.Free(info.handle);
-            resources<R>.erase(p_id);
+        }
+        Release<R>(p_id, info);
+    }
+
+    // Usage of resources of type R that get loaded from now on
+    template <IsResource R>
+    static void SetDefaultUsage(Usage p_usage) {
+        std::lock_guard lock(mutex<R>);
+        cache<R>.default_usage = p_usage;
+    }
+
+    template <IsResource R>
+    static void SetUsage(StringID p_id, Usage p_usage) {
+        std::lock_guard lock(mutex<R>);
+        if (!resources<R>.contains(p_id)) {
+            std::println("Can not set usage of {}, resource is not loaded", p_id);
             return;
         }
+        auto& info = resources<R>[p_id];
+        info.usage = p_usage;
+        if (info.cache_position.has_value() && p_usage != CACHE_WHEN_UNUSED) {
+            cache<R>.lru.erase(info.cache_position.value());
+            cache<R>.stats.cached_bytes -= info.size;
+            info.cache_position.reset();
+            Release<R>(p_id, info);
+        }
+    }
+
+    // Maximum number of bytes kept in unused resources of type R with usage CACHE_WHEN_UNUSED
+    template <IsResource R>
+    static void SetCacheBudget(size_t p_bytes) {
+        std::lock_guard lock(mutex<R>);
+        cache<R>.stats.budget = p_bytes;
+        Evict<R>();
+    }
+
+    template <IsResource R>
+    static CacheStats GetCacheStats() {
+        std::lock_guard lock(mutex<R>);
+        return cache<R>.stats;
     }
 };
 
-}  // namespace Gauge
\ No newline at end of file
+}  // namespace Gauge
@@ -1,16 +1,83 @@
 #include "string_id.hpp"
+
+#include <array>
+#include <cassert>
+#include <mutex>
+#include <print>
+#include <shared_mutex>
 #include <string>
 
 using namespace Gauge;
 
-Pool<std::string> StringID::string_pool;
-std::unordered_map<std::string, Handle<std::string>> StringID::id_map;
+namespace {
+
+// The reverse table is split into shards selected by the low bits of the hash,
+// so StringIDs can be created from loader threads and physics jobs. Lookups
+// only take a shared lock on one shard and inserts only contend with other
+// inserts into the same shard. Entries are never removed, so references into
+// a shard stay valid after its lock is released.
+constexpr uint SHARD_COUNT = 64;
+
+struct Shard {
+    std::shared_mutex mutex;
+    std::unordered_map<uint64_t, std::string> strings;
+};
+
+// Avoid static initialization order problem with the Construct On First Use Idiom,
+// literals register themselves during static initialization in debug builds
+std::array<Shard, SHARD_COUNT>& GetShards() {
+    static std::array<Shard, SHARD_COUNT> shards;
+    return shards;
+}
+
+Shard& GetShard(uint64_t p_id) {
+    return GetShards()[p_id & (SHARD_COUNT - 1)];
+}
+
+}  // namespace
+
+bool StringID::Register(std::string_view p_string, uint64_t p_id) {
+    Shard& shard = GetShard(p_id);
+    const std::string* existing = nullptr;
+    {
+        std::shared_lock lock(shard.mutex);
+        auto entry = shard.strings.find(p_id);
+        if (entry != shard.strings.end()) {
+            existing = &entry->second;
+        }
+    }
+
+    if (existing == nullptr) {
+        std::unique_lock lock(shard.mutex);
+        auto [entry, inserted] = shard.strings.try_emplace(p_id, p_string);
+        if (inserted) {
+            return true;
+        }
+        existing = &entry->second;
+    }
+
+#ifndef NDEBUG
+    if (*existing != p_string) {
+        std::println("StringID collision: '{}' and '{}' both hash to {:016x}", *existing, p_string, p_id);
+        assert(false);
+        return false;
+    }
+#endif
+    return true;
+}
 
-StringID Gauge::operator""_id(const char* p_string, unsigned long) {
-    std::string string(p_string);
-    if (StringID::id_map.contains(string)) {
-        return StringID::id_map[p_string];
+const std::string* StringID::Lookup(uint64_t p_id) {
+    Shard& shard = GetShard(p_id);
+    std::shared_lock lock(shard.mutex);
+    auto entry = shard.strings.find(p_id);
+    if (entry == shard.strings.end()) {
+        return nullptr;
     }
+    return &entry->second;
+}
 
-    return StringID(string);
-}
\ No newline at end of file
+const std::string& StringID::GetString() const {
+    static const std::string unknown;
+    const std::string* string = Lookup(id);
+    return string != nullptr ? *string : unknown;
+}
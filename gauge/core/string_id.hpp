@@ -1,68 +1,112 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <format>
-#include <gauge/core/pool.hpp>
-
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 namespace Gauge {
 
+// Helper to pass string literals as template arguments
+template <size_t N>
+struct StringLiteral {
+    char data[N]{};
+
+    consteval StringLiteral(const char (&p_string)[N]) {
+        std::copy_n(p_string, N, data);
+    }
+
+    constexpr std::string_view View() const {
+        return std::string_view(data, N - 1);
+    }
+};
+
+// A StringID is the 64 bit FNV-1a hash of its string. Comparing and hashing
+// never touches the string table; literals created with _id are hashed at
+// compile time.
+//
+// Strings created at runtime are recorded in a reverse table so they can be
+// turned back into text (resource paths, node names). String literals are only
+// recorded in debug builds, where every insertion is also checked for hash
+// collisions. The reverse table is sharded and safe to use from any thread.
 class StringID {
    public:
-    static Pool<std::string> string_pool;
-    static std::unordered_map<std::string, Handle<std::string>> id_map;
-
-    Handle<std::string> handle;
+    uint64_t id{};
 
-    constexpr StringID() {}
-    constexpr StringID(Handle<std::string> p_handle) : handle(p_handle) {}
-    constexpr StringID(std::string p_string) {
-        if (!id_map.contains(p_string)) {
-            handle = string_pool.Allocate(p_string);
-            id_map[p_string] = handle;
-        } else {
-            handle = id_map[p_string];
+    static constexpr uint64_t Hash(std::string_view p_string) {
+        uint64_t hash = 14695981039346656037ull;
+        for (const char character : p_string) {
+            hash ^= static_cast<uint8_t>(character);
+            hash *= 1099511628211ull;
         }
+        return hash;
     }
-    constexpr StringID(const char* p_string) : Gauge::StringID(std::string(p_string)) {}
 
-    inline constexpr operator std::string*() const {
-        return string_pool.Get(handle);
+    static constexpr StringID FromHash(uint64_t p_id) {
+        StringID string_id;
+        string_id.id = p_id;
+        return string_id;
     }
 
-    inline constexpr operator std::string&() const {
-        return *string_pool.Get(handle);
+    // Records p_string in the reverse table, returns false on a hash collision
+    static bool Register(std::string_view p_string, uint64_t p_id);
+    // Returns nullptr if the string of p_id was never recorded
+    static const std::string* Lookup(uint64_t p_id);
+
+    constexpr StringID() {}
+    StringID(std::string_view p_string) : id(Hash(p_string)) {
+        Register(p_string, id);
     }
+    StringID(const std::string& p_string) : StringID(std::string_view(p_string)) {}
+    StringID(const char* p_string) : StringID(std::string_view(p_string)) {}
 
-    inline constexpr std::string& GetString() const {
-        return *string_pool.Get(handle);
+    inline operator const std::string&() const {
+        return GetString();
     }
 
+    const std::string& GetString() const;
+
     inline constexpr operator uint64_t() const {
-        return (uint64_t)handle;
+        return id;
     }
 
     constexpr size_t hash() const {
-        return handle.hash();
+        return static_cast<size_t>(id);
     }
 
     constexpr bool operator==(const StringID& rhs) const {
-        return handle == rhs.handle;
+        return id == rhs.id;
     }
 
     class HashFunction {
        public:
         constexpr size_t operator()(const StringID& string_id) const {
-            return string_id.handle.hash();
+            return string_id.hash();
         }
     };
 
     template <typename T>
     using Map = std::unordered_map<StringID, T, StringID::HashFunction>;
+
+#ifndef NDEBUG
+    template <StringLiteral S>
+    inline static const bool literal_registered = Register(S.View(), Hash(S.View()));
+#endif
 };
 
-StringID operator""_id(const char* p_string, unsigned long);
+template <StringLiteral S>
+constexpr StringID operator""_id() {
+    constexpr uint64_t id = StringID::Hash(S.View());
+#ifndef NDEBUG
+    if !consteval {
+        (void)StringID::literal_registered<S>;
+    }
+#endif
+    return StringID::FromHash(id);
+}
 
 }  // namespace Gauge
 
@@ -74,7 +118,11 @@ struct formatter<Gauge::StringID> {
     }
 
     auto format(const Gauge::StringID& obj, format_context& ctx) const {
-        return formatter<std::string>().format(string(obj), ctx);
+        const string* text = Gauge::StringID::Lookup(obj.id);
+        if (text == nullptr) {
+            return format_to(ctx.out(), "#{:016x}", obj.id);
+        }
+        return formatter<std::string>().format(*text, ctx);
     }
 };
 }  // namespace std
\ No newline at end of file
@@ -0,0 +1,306 @@
+#include "batch.hpp"
+
+#include <gauge/renderer/aabb.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+using namespace Gauge;
+
+namespace {
+
+#if defined(__AVX2__)
+struct Lanes {
+    static constexpr uint WIDTH = 8;
+    __m256 v;
+
+    static Lanes Load(const float* p_data) { return {_mm256_load_ps(p_data)}; }
+    static Lanes Set(float p_value) { return {_mm256_set1_ps(p_value)}; }
+    void Store(float* r_data) const { _mm256_store_ps(r_data, v); }
+};
+inline Lanes operator+(Lanes a, Lanes b) { return {_mm256_add_ps(a.v, b.v)}; }
+inline Lanes operator-(Lanes a, Lanes b) { return {_mm256_sub_ps(a.v, b.v)}; }
+inline Lanes operator*(Lanes a, Lanes b) { return {_mm256_mul_ps(a.v, b.v)}; }
+inline Lanes Min(Lanes a, Lanes b) { return {_mm256_min_ps(a.v, b.v)}; }
+inline Lanes Max(Lanes a, Lanes b) { return {_mm256_max_ps(a.v, b.v)}; }
+inline Lanes Abs(Lanes a) { return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)}; }
+#elif defined(__SSE2__)
+struct Lanes {
+    static constexpr uint WIDTH = 4;
+    __m128 v;
+
+    static Lanes Load(const float* p_data) { return {_mm_load_ps(p_data)}; }
+    static Lanes Set(float p_value) { return {_mm_set1_ps(p_value)}; }
+    void Store(float* r_data) const { _mm_store_ps(r_data, v); }
+};
+inline Lanes operator+(Lanes a, Lanes b) { return {_mm_add_ps(a.v, b.v)}; }
+inline Lanes operator-(Lanes a, Lanes b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline Lanes operator*(Lanes a, Lanes b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline Lanes Min(Lanes a, Lanes b) { return {_mm_min_ps(a.v, b.v)}; }
+inline Lanes Max(Lanes a, Lanes b) { return {_mm_max_ps(a.v, b.v)}; }
+inline Lanes Abs(Lanes a) { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)}; }
+#else
+struct Lanes {
+    static constexpr uint WIDTH = 1;
+    float v;
+
+    static Lanes Load(const float* p_data) { return {*p_data}; }
+    static Lanes Set(float p_value) { return {p_value}; }
+    void Store(float* r_data) const { *r_data = v; }
+};
+inline Lanes operator+(Lanes a, Lanes b) { return {a.v + b.v}; }
+inline Lanes operator-(Lanes a, Lanes b) { return {a.v - b.v}; }
+inline Lanes operator*(Lanes a, Lanes b) { return {a.v * b.v}; }
+inline Lanes Min(Lanes a, Lanes b) { return {std::min(a.v, b.v)}; }
+inline Lanes Max(Lanes a, Lanes b) { return {std::max(a.v, b.v)}; }
+inline Lanes Abs(Lanes a) { return {std::abs(a.v)}; }
+#endif
+
+constexpr uint WIDTH = Lanes::WIDTH;
+
+// One float array per component, WIDTH elements each
+template <uint COMPONENTS>
+struct alignas(32) Block {
+    float data[COMPONENTS][WIDTH];
+
+    Lanes Load(uint p_component) const { return Lanes::Load(data[p_component]); }
+    void Store(uint p_component, Lanes p_lanes) { p_lanes.Store(data[p_component]); }
+};
+
+struct TransformLanes {
+    Lanes px, py, pz;
+    Lanes qx, qy, qz, qw;
+    Lanes s;
+};
+
+// Rotation matrix of a quaternion, m[row][column]
+struct RotationLanes {
+    Lanes m[3][3];
+};
+
+const Transform& TransformAt(const Transform* p_transforms, uint p_index, size_t p_stride) {
+    return *reinterpret_cast<const Transform*>(reinterpret_cast<const std::byte*>(p_transforms) + p_index * p_stride);
+}
+
+// Lanes past p_count are filled with the identity
+void GatherTransforms(Block<8>& r_block, const Transform* p_transforms, uint p_count, size_t p_stride) {
+    for (uint i = 0; i < WIDTH; ++i) {
+        const Transform& transform = i < p_count ? TransformAt(p_transforms, i, p_stride) : Transform::IDENTITY;
+        r_block.data[0][i] = transform.position.x;
+        r_block.data[1][i] = transform.position.y;
+        r_block.data[2][i] = transform.position.z;
+        r_block.data[3][i] = transform.rotation.x;
+        r_block.data[4][i] = transform.rotation.y;
+        r_block.data[5][i] = transform.rotation.z;
+        r_block.data[6][i] = transform.rotation.w;
+        r_block.data[7][i] = transform.scale;
+    }
+}
+
+TransformLanes LoadTransforms(const Block<8>& p_block) {
+    return TransformLanes{
+        p_block.Load(0), p_block.Load(1), p_block.Load(2),
+        p_block.Load(3), p_block.Load(4), p_block.Load(5), p_block.Load(6),
+        p_block.Load(7)};
+}
+
+void StoreTransforms(Block<8>& r_block, const TransformLanes& p_transform) {
+    r_block.Store(0, p_transform.px);
+    r_block.Store(1, p_transform.py);
+    r_block.Store(2, p_transform.pz);
+    r_block.Store(3, p_transform.qx);
+    r_block.Store(4, p_transform.qy);
+    r_block.Store(5, p_transform.qz);
+    r_block.Store(6, p_transform.qw);
+    r_block.Store(7, p_transform.s);
+}
+
+RotationLanes ToRotation(const TransformLanes& p_transform) {
+    const Lanes one = Lanes::Set(1.0f);
+    const Lanes two = Lanes::Set(2.0f);
+    const Lanes x = p_transform.qx, y = p_transform.qy, z = p_transform.qz, w = p_transform.qw;
+    const Lanes xx = x * x, yy = y * y, zz = z * z;
+    const Lanes xy = x * y, xz = x * z, yz = y * z;
+    const Lanes wx = w * x, wy = w * y, wz = w * z;
+
+    RotationLanes rotation;
+    rotation.m[0][0] = one - two * (yy + zz);
+    rotation.m[0][1] = two * (xy - wz);
+    rotation.m[0][2] = two * (xz + wy);
+    rotation.m[1][0] = two * (xy + wz);
+    rotation.m[1][1] = one - two * (xx + zz);
+    rotation.m[1][2] = two * (yz - wx);
+    rotation.m[2][0] = two * (xz - wy);
+    rotation.m[2][1] = two * (yz + wx);
+    rotation.m[2][2] = one - two * (xx + yy);
+    return rotation;
+}
+
+TransformLanes Compose(const TransformLanes& a, const TransformLanes& b) {
+    const Lanes two = Lanes::Set(2.0f);
+    TransformLanes result;
+
+    // a.q * (a.s * b.p) as v + w * t + cross(q, t) with t = 2 * cross(q, v)
+    const Lanes vx = a.s * b.px, vy = a.s * b.py, vz = a.s * b.pz;
+    const Lanes tx = two * (a.qy * vz - a.qz * vy);
+    const Lanes ty = two * (a.qz * vx - a.qx * vz);
+    const Lanes tz = two * (a.qx * vy - a.qy * vx);
+    result.px = a.px + vx + a.qw * tx + (a.qy * tz - a.qz * ty);
+    result.py = a.py + vy + a.qw * ty + (a.qz * tx - a.qx * tz);
+    result.pz = a.pz + vz + a.qw * tz + (a.qx * ty - a.qy * tx);
+
+    result.qw = a.qw * b.qw - a.qx * b.qx - a.qy * b.qy - a.qz * b.qz;
+    result.qx = a.qw * b.qx + a.qx * b.qw + a.qy * b.qz - a.qz * b.qy;
+    result.qy = a.qw * b.qy - a.qx * b.qz + a.qy * b.qw + a.qz * b.qx;
+    result.qz = a.qw * b.qz + a.qx * b.qy - a.qy * b.qx + a.qz * b.qw;
+
+    result.s = a.s * b.s;
+    return result;
+}
+
+}  // namespace
+
+uint Math::GetBatchWidth() {
+    return WIDTH;
+}
+
+void Math::ComposeTransforms(std::span<const Transform> p_parents, std::span<const Transform> p_locals, std::span<Transform> r_transforms) {
+    assert(p_parents.size() == p_locals.size() && r_transforms.size() == p_locals.size());
+    Block<8> parents, locals, results;
+    for (uint first = 0; first < r_transforms.size(); first += WIDTH) {
+        const uint count = std::min<uint>(WIDTH, r_transforms.size() - first);
+        GatherTransforms(parents, &p_parents[first], count, sizeof(Transform));
+        GatherTransforms(locals, &p_locals[first], count, sizeof(Transform));
+
+        StoreTransforms(results, Compose(LoadTransforms(parents), LoadTransforms(locals)));
+
+        for (uint i = 0; i < count; ++i) {
+            Transform& transform = r_transforms[first + i];
+            transform.position = Vec3(results.data[0][i], results.data[1][i], results.data[2][i]);
+            transform.rotation = Quaternion(results.data[6][i], results.data[3][i], results.data[4][i], results.data[5][i]);
+            transform.scale = results.data[7][i];
+        }
+    }
+}
+
+void Math::TransformsToMatrices(const Transform* p_transforms, uint p_count, Mat4* r_matrices, size_t p_stride, size_t p_matrix_stride) {
+    Block<8> transforms;
+    Block<12> columns;
+    for (uint first = 0; first < p_count; first += WIDTH) {
+        const uint count = std::min(WIDTH, p_count - first);
+        GatherTransforms(transforms, &TransformAt(p_transforms, first, p_stride), count, p_stride);
+
+        // Translation * rotation * scale
+        const TransformLanes transform = LoadTransforms(transforms);
+        const RotationLanes rotation = ToRotation(transform);
+        for (uint column = 0; column < 3; ++column) {
+            for (uint row = 0; row < 3; ++row) {
+                columns.Store(column * 3 + row, rotation.m[row][column] * transform.s);
+            }
+        }
+        columns.Store(9, transform.px);
+        columns.Store(10, transform.py);
+        columns.Store(11, transform.pz);
+
+        for (uint i = 0; i < count; ++i) {
+            Mat4& matrix = *reinterpret_cast<Mat4*>(reinterpret_cast<char*>(r_matrices) + (first + i) * p_matrix_stride);
+            for (uint column = 0; column < 4; ++column) {
+                matrix[column] = Vec4(
+                    columns.data[column * 3 + 0][i],
+                    columns.data[column * 3 + 1][i],
+                    columns.data[column * 3 + 2][i],
+                    column == 3 ? 1.0f : 0.0f);
+            }
+        }
+    }
+}
+
+void Math::TransformAABBs(std::span<const Transform> p_transforms, std::span<const AABB> p_aabbs, std::span<AABB> r_aabbs) {
+    assert(p_transforms.size() == p_aabbs.size() && r_aabbs.size() == p_aabbs.size());
+    Block<8> transforms;
+    Block<6> aabbs;
+    for (uint first = 0; first < r_aabbs.size(); first += WIDTH) {
+        const uint count = std::min<uint>(WIDTH, r_aabbs.size() - first);
+        GatherTransforms(transforms, &p_transforms[first], count, sizeof(Transform));
+        for (uint i = 0; i < WIDTH; ++i) {
+            const AABB& aabb = i < count ? p_aabbs[first + i] : p_aabbs[first];
+            const Vec3 center = aabb.GetCenter();
+            const Vec3 extent = aabb.GetExtent();
+            for (uint axis = 0; axis < 3; ++axis) {
+                aabbs.data[axis][i] = center[axis];
+                aabbs.data[3 + axis][i] = extent[axis];
+            }
+        }
+
+        // See Transform::operator*(AABB)
+        const TransformLanes transform = LoadTransforms(transforms);
+        const RotationLanes rotation = ToRotation(transform);
+        const Lanes translation[3] = {transform.px, transform.py, transform.pz};
+        const Lanes center[3] = {aabbs.Load(0), aabbs.Load(1), aabbs.Load(2)};
+        const Lanes half_size[3] = {aabbs.Load(3), aabbs.Load(4), aabbs.Load(5)};
+        for (uint row = 0; row < 3; ++row) {
+            Lanes position = Lanes::Set(0.0f);
+            Lanes extent = Lanes::Set(0.0f);
+            for (uint column = 0; column < 3; ++column) {
+                position = position + rotation.m[row][column] * center[column];
+                extent = extent + Abs(rotation.m[row][column]) * half_size[column];
+            }
+            aabbs.Store(row, translation[row] + position * transform.s);
+            aabbs.Store(3 + row, extent * transform.s);
+        }
+
+        for (uint i = 0; i < count; ++i) {
+            r_aabbs[first + i] = AABB(
+                Vec3(aabbs.data[0][i], aabbs.data[1][i], aabbs.data[2][i]),
+                Vec3(aabbs.data[3][i], aabbs.data[4][i], aabbs.data[5][i]));
+        }
+    }
+}
+
+AABB Math::ComputeBounds(const Vec3* p_positions, uint p_count, size_t p_stride) {
+    if (p_count == 0) {
+        return AABB();
+    }
+    auto position_at = [&](uint p_index) -> const Vec3& {
+        return *reinterpret_cast<const Vec3*>(reinterpret_cast<const std::byte*>(p_positions) + p_index * p_stride);
+    };
+
+    // Lanes past the end repeat the first position, which is inside anyway
+    Block<3> positions;
+    Lanes min[3], max[3];
+    for (uint axis = 0; axis < 3; ++axis) {
+        min[axis] = Lanes::Set(position_at(0)[axis]);
+        max[axis] = min[axis];
+    }
+    for (uint first = 0; first < p_count; first += WIDTH) {
+        const uint count = std::min(WIDTH, p_count - first);
+        for (uint i = 0; i < WIDTH; ++i) {
+            const Vec3& position = position_at(i < count ? first + i : 0);
+            positions.data[0][i] = position.x;
+            positions.data[1][i] = position.y;
+            positions.data[2][i] = position.z;
+        }
+        for (uint axis = 0; axis < 3; ++axis) {
+            min[axis] = Min(min[axis], positions.Load(axis));
+            max[axis] = Max(max[axis], positions.Load(axis));
+        }
+    }
+
+    Block<6> bounds;
+    for (uint axis = 0; axis < 3; ++axis) {
+        bounds.Store(axis, min[axis]);
+        bounds.Store(3 + axis, max[axis]);
+    }
+    Vec3 result_min = position_at(0), result_max = position_at(0);
+    for (uint i = 0; i < WIDTH; ++i) {
+        for (uint axis = 0; axis < 3; ++axis) {
+            result_min[axis] = std::min(result_min[axis], bounds.data[axis][i]);
+            result_max[axis] = std::max(result_max[axis], bounds.data[3 + axis][i]);
+        }
+    }
+    return AABB::FromMinMax(result_min, result_max);
+}
\ No newline at end of file
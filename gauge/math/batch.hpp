@@ -0,0 +1,39 @@
+#pragma once
+
+#include <gauge/common.hpp>
+#include <gauge/math/common.hpp>
+#include <gauge/math/transform.hpp>
+
+#include <cstddef>
+#include <span>
+
+namespace Gauge {
+
+class AABB;
+
+// Kernels that process many transforms or bounds at once. Inputs are
+// transposed into blocks of one value per lane, so the math runs on every
+// lane with the same instructions. Built for AVX2 when compiled with it
+// (GAUGE_AVX2), for SSE on other x86-64 targets and scalar everywhere else.
+namespace Math {
+
+// Number of elements computed together
+uint GetBatchWidth();
+
+// r_transforms[i] = p_parents[i] * p_locals[i], r_transforms may alias either input
+void ComposeTransforms(std::span<const Transform> p_parents, std::span<const Transform> p_locals, std::span<Transform> r_transforms);
+
+// r_matrices[i] = transform i's GetMatrix(). The strides are the distances
+// between transforms and matrices in bytes, so they can be read from and
+// written into larger structs.
+void TransformsToMatrices(const Transform* p_transforms, uint p_count, Mat4* r_matrices, size_t p_stride = sizeof(Transform), size_t p_matrix_stride = sizeof(Mat4));
+
+// r_aabbs[i] = p_transforms[i] * p_aabbs[i] for valid boxes, r_aabbs may alias p_aabbs
+void TransformAABBs(std::span<const Transform> p_transforms, std::span<const AABB> p_aabbs, std::span<AABB> r_aabbs);
+
+// Bounds of p_count positions p_stride bytes apart, invalid if there are none
+AABB ComputeBounds(const Vec3* p_positions, uint p_count, size_t p_stride = sizeof(Vec3));
+
+}  // namespace Math
+
+}  // namespace Gauge
\ No newline at end of file
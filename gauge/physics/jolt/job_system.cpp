@@ -0,0 +1,52 @@
+#include "job_system.hpp"
+
+#include <chrono>
+#include <thread>
+
+using namespace Gauge;
+using namespace Physics;
+
+JoltJobSystem::JoltJobSystem(JobSystem& p_job_system, uint p_max_jobs, uint p_max_barriers)
+    : JobSystemWithBarrier(p_max_barriers), job_system(p_job_system) {
+    jobs.Init(p_max_jobs, p_max_jobs);
+}
+
+int JoltJobSystem::GetMaxConcurrency() const {
+    // The thread waiting on a barrier executes jobs as well
+    return job_system.GetThreadCount() + 1;
+}
+
+JPH::JobHandle JoltJobSystem::CreateJob(const char* inName, JPH::ColorArg inColor, const JobFunction& inJobFunction, JPH::uint32 inNumDependencies) {
+    JPH::uint32 index;
+    while ((index = jobs.ConstructObject(inName, inColor, this, inJobFunction, inNumDependencies)) == decltype(jobs)::cInvalidObjectIndex) {
+        JPH_ASSERT(false, "No jobs available!");
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    Job* job = &jobs.Get(index);
+
+    // Taking the handle adds a reference before the job can finish
+    JobHandle handle(job);
+    if (inNumDependencies == 0) {
+        QueueJob(job);
+    }
+    return handle;
+}
+
+void JoltJobSystem::QueueJob(Job* inJob) {
+    inJob->AddRef();
+    job_system.Submit([inJob]() {
+        // Barriers may have executed the job already, Execute handles that
+        inJob->Execute();
+        inJob->Release();
+    });
+}
+
+void JoltJobSystem::QueueJobs(Job** inJobs, JPH::uint inNumJobs) {
+    for (JPH::uint i = 0; i < inNumJobs; ++i) {
+        QueueJob(inJobs[i]);
+    }
+}
+
+void JoltJobSystem::FreeJob(Job* inJob) {
+    jobs.DestructObject(inJob);
+}
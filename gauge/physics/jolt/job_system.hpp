@@ -0,0 +1,33 @@
+#pragma once
+
+#include <gauge/core/job_system.hpp>
+
+#include <Jolt/Jolt.h>
+
+#include <Jolt/Core/FixedSizeFreeList.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+
+namespace Gauge {
+namespace Physics {
+
+// Runs Jolt's jobs on the engine's JobSystem so physics and engine work
+// share one set of threads
+class JoltJobSystem final : public JPH::JobSystemWithBarrier {
+    JobSystem& job_system;
+    JPH::FixedSizeFreeList<Job> jobs;
+
+   public:
+    virtual int GetMaxConcurrency() const override;
+    virtual JobHandle CreateJob(const char* inName, JPH::ColorArg inColor, const JobFunction& inJobFunction, JPH::uint32 inNumDependencies = 0) override;
+
+   protected:
+    virtual void QueueJob(Job* inJob) override;
+    virtual void QueueJobs(Job** inJobs, JPH::uint inNumJobs) override;
+    virtual void FreeJob(Job* inJob) override;
+
+   public:
+    JoltJobSystem(JobSystem& p_job_system, uint p_max_jobs, uint p_max_barriers);
+};
+
+}  // namespace Physics
+}  // namespace Gauge
@@ -4,7 +4,6 @@
 #include <Jolt/Jolt.h>
 
 #include <Jolt/Core/Factory.h>
-#include <Jolt/Core/JobSystemThreadPool.h>
 #include <Jolt/Core/TempAllocator.h>
 #include <Jolt/Math/Vec3.h>
 #include <Jolt/Physics/Body/BodyActivationListener.h>
@@ -119,7 +118,7 @@ void JoltBackend::Initialize() {
     JPH::RegisterTypes();
 
     temp_allocator = std::make_unique<JPH::TempAllocatorImpl>(10 * 1024 * 1024);
-    job_system = std::make_unique<JPH::JobSystemThreadPool>(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, std::thread::hardware_concurrency() - 1);
+    job_system = std::make_unique<JoltJobSystem>(JobSystem::Get(), JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
 
     physics_system.Init(
         cMaxBodies,
@@ -138,6 +137,11 @@ void JoltBackend::Initialize() {
 }
 
 void JoltBackend::Finalize() {
+    for (const JPH::BodyID& body_id : body_ids) {
+        body_interface->RemoveBody(body_id);
+        body_interface->DestroyBody(body_id);
+    }
+
     JPH::UnregisterTypes();
     JPH::Factory::sInstance = nullptr;
 }
@@ -170,7 +174,7 @@ JoltBackend::ShapeCreateMesh(std::vector<Vec3> p_vertices, std::vector<uint> p_i
     auto mesh_settings = new JPH::MeshShapeSettings(
         triangles,
         JPH::PhysicsMaterialList({JPH ::PhysicsMaterial::sDefault}));
-    return shapes.Allocate(mesh_settings->Create().Get());
+    return shapes.Allocate(mesh_settings->Create().Get()).ToUint();
 }
 
 BodyHandle
@@ -1,11 +1,12 @@
 #pragma once
 
+#include <gauge/core/dense_pool.hpp>
 #include <gauge/core/pool.hpp>
+#include <gauge/physics/jolt/job_system.hpp>
 #include <gauge/physics/physics.hpp>
 
 #include <Jolt/Jolt.h>
 
-#include <Jolt/Core/JobSystemThreadPool.h>
 #include <Jolt/Physics/Body/Body.h>
 #include <Jolt/Physics/Collision/Shape/Shape.h>
 #include <Jolt/Physics/PhysicsSystem.h>
@@ -58,7 +59,7 @@ class JoltBackend final : public Physics::Backend {
     static constexpr uint cMaxContactConstraints = 10240;
 
     Pool<JPH::Shape*> shapes;
-    Pool<JPH::BodyID> body_ids;
+    DensePool<JPH::BodyID> body_ids;
 
     class BPLayerInterfaceImpl final : public JPH::BroadPhaseLayerInterface {
        public:
@@ -93,7 +94,7 @@ class JoltBackend final : public Physics::Backend {
     JPH::PhysicsSystem physics_system;
     JPH::BodyInterface* body_interface;
     std::unique_ptr<JPH::TempAllocatorImpl> temp_allocator;
-    std::unique_ptr<JPH::JobSystemThreadPool> job_system;
+    std::unique_ptr<JoltJobSystem> job_system;
 
    public:
     virtual void Initialize() final override;
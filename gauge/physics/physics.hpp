@@ -2,13 +2,15 @@
 
 #include <sys/types.h>
 #include <gauge/math/transform.hpp>
+#include <cstdint>
 #include <vector>
 
 namespace Gauge {
 namespace Physics {
 
-using ShapeHandle = uint;
-using BodyHandle = uint;
+// Handle::ToUint of the backend's pools
+using ShapeHandle = uint64_t;
+using BodyHandle = uint64_t;
 
 enum class Layer : uint16_t {
     STATIC = 0,
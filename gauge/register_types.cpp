@@ -7,6 +7,7 @@
 #include <gauge/components/mesh_instance.hpp>
 #include <gauge/components/model.hpp>
 #include <gauge/components/physics/static_body.hpp>
+#include <gauge/components/streamed_scene.hpp>
 #include <gauge/core/app.hpp>
 #include <gauge/input/input.hpp>
 #include <gauge/physics/jolt/jolt.hpp>
@@ -39,6 +40,7 @@ static void RegisterComponents() {
     RegisterComponent<ModelComponent>();
     RegisterComponent<StaticBody>();
     RegisterComponent<PointLight>();
+    RegisterComponent<StreamedScene>();
 }
 
 void Gauge::RegisterShaders() {
@@ -2,51 +2,84 @@
 
 #include <gauge/math/transform.hpp>
 
+#include <glm/vector_relational.hpp>
+
+#include <algorithm>
+
 using namespace Gauge;
 
 bool AABB::IsPointInside(Vec3 p_point) const {
-    return (
-        p_point.x <= (position.x + extent.x) && p_point.x >= (position.x - extent.x) &&
-        p_point.y <= (position.y + extent.y) && p_point.y >= (position.y - extent.y) &&
-        p_point.z <= (position.z + extent.z) && p_point.z >= (position.z - extent.z));
+    return glm::all(glm::lessThanEqual(glm::vec3(min), glm::vec3(p_point))) && glm::all(glm::lessThanEqual(glm::vec3(p_point), glm::vec3(max)));
 }
 
 void AABB::Grow(Vec3 p_point) {
-    if (!valid) {
-        position = p_point;
-        valid = true;
-        return;
-    }
-    if (p_point.x > (position.x + extent.x)) {
-        position.x = ((position.x - extent.x) + p_point.x) / 2.0;
-        extent.x = p_point.x - position.x;
-    } else if (p_point.x < (position.x - extent.x)) {
-        position.x = ((position.x + extent.x) + p_point.x) / 2.0;
-        extent.x = position.x - p_point.x;
-    }
-    if (p_point.y > (position.y + extent.y)) {
-        position.y = ((position.y - extent.y) + p_point.y) / 2.0;
-        extent.y = p_point.y - position.y;
-    } else if (p_point.y < (position.y - extent.y)) {
-        position.y = ((position.y + extent.y) + p_point.y) / 2.0;
-        extent.y = position.y - p_point.y;
-    }
-    if (p_point.z > (position.z + extent.z)) {
-        position.z = ((position.z - extent.z) + p_point.z) / 2.0;
-        extent.z = p_point.z - position.z;
-    } else if (p_point.z < (position.z - extent.z)) {
-        position.z = ((position.z + extent.z) + p_point.z) / 2.0;
-        extent.z = position.z - p_point.z;
+    min = glm::min(glm::vec3(min), glm::vec3(p_point));
+    max = glm::max(glm::vec3(max), glm::vec3(p_point));
+}
+
+void AABB::Grow(const AABB& p_other) {
+    min = glm::min(glm::vec3(min), glm::vec3(p_other.min));
+    max = glm::max(glm::vec3(max), glm::vec3(p_other.max));
+}
+
+float AABB::GetSurfaceArea() const {
+    const Vec3 size = max - min;
+    return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+AABB AABB::Expanded(float p_margin) const {
+    return FromMinMax(min - Vec3(p_margin), max + Vec3(p_margin));
+}
+
+bool AABB::Contains(const AABB& p_other) const {
+    return glm::all(glm::lessThanEqual(glm::vec3(min), glm::vec3(p_other.min))) && glm::all(glm::lessThanEqual(glm::vec3(p_other.max), glm::vec3(max)));
+}
+
+bool AABB::Intersects(const AABB& p_other) const {
+    return glm::all(glm::lessThanEqual(glm::vec3(min), glm::vec3(p_other.max))) && glm::all(glm::lessThanEqual(glm::vec3(p_other.min), glm::vec3(max)));
+}
+
+bool AABB::IntersectsSphere(Vec3 p_center, float p_radius) const {
+    const glm::vec3 closest = glm::clamp(glm::vec3(p_center), glm::vec3(min), glm::vec3(max));
+    const glm::vec3 offset = closest - glm::vec3(p_center);
+    return glm::dot(offset, offset) <= p_radius * p_radius;
+}
+
+bool AABB::IntersectsRay(Vec3 p_origin, Vec3 p_inverse_direction, float p_max_distance, float& r_distance) const {
+    const glm::vec3 t0 = (glm::vec3(min) - glm::vec3(p_origin)) * glm::vec3(p_inverse_direction);
+    const glm::vec3 t1 = (glm::vec3(max) - glm::vec3(p_origin)) * glm::vec3(p_inverse_direction);
+    const glm::vec3 near = glm::min(t0, t1);
+    const glm::vec3 far = glm::max(t0, t1);
+    const float enter = std::max(std::max(near.x, near.y), std::max(near.z, 0.0f));
+    const float exit = std::min(std::min(far.x, far.y), std::min(far.z, p_max_distance));
+    if (enter > exit) {
+        return false;
     }
+    r_distance = enter;
+    return true;
+}
+
+bool AABB::IsOutsidePlane(const Vec4& p_plane) const {
+    // Corner furthest along the normal
+    const glm::vec3 normal(p_plane);
+    const glm::vec3 corner = glm::mix(glm::vec3(min), glm::vec3(max), glm::greaterThanEqual(normal, glm::vec3(0.0f)));
+    return glm::dot(normal, corner) + p_plane.w < 0.0f;
+}
+
+bool AABB::IsInsidePlane(const Vec4& p_plane) const {
+    // Corner furthest against the normal
+    const glm::vec3 normal(p_plane);
+    const glm::vec3 corner = glm::mix(glm::vec3(max), glm::vec3(min), glm::greaterThanEqual(normal, glm::vec3(0.0f)));
+    return glm::dot(normal, corner) + p_plane.w >= 0.0f;
+}
+
+AABB AABB::FromMinMax(Vec3 p_min, Vec3 p_max) {
+    AABB aabb;
+    aabb.min = p_min;
+    aabb.max = p_max;
+    return aabb;
 }
 
-void AABB::Grow(AABB p_other) {
-    Grow(p_other.position + Vec3(p_other.extent.x, p_other.extent.y, p_other.extent.z));
-    Grow(p_other.position + Vec3(p_other.extent.x, p_other.extent.y, -p_other.extent.z));
-    Grow(p_other.position + Vec3(p_other.extent.x, -p_other.extent.y, p_other.extent.z));
-    Grow(p_other.position + Vec3(p_other.extent.x, -p_other.extent.y, -p_other.extent.z));
-    Grow(p_other.position + Vec3(-p_other.extent.x, p_other.extent.y, p_other.extent.z));
-    Grow(p_other.position + Vec3(-p_other.extent.x, p_other.extent.y, -p_other.extent.z));
-    Grow(p_other.position + Vec3(-p_other.extent.x, -p_other.extent.y, p_other.extent.z));
-    Grow(p_other.position + Vec3(-p_other.extent.x, -p_other.extent.y, -p_other.extent.z));
+AABB AABB::Merge(const AABB& p_a, const AABB& p_b) {
+    return FromMinMax(glm::min(glm::vec3(p_a.min), glm::vec3(p_b.min)), glm::max(glm::vec3(p_a.max), glm::vec3(p_b.max)));
 }
\ No newline at end of file
@@ -3,42 +3,80 @@
 #include <gauge/math/common.hpp>
 #include <gauge/math/transform.hpp>
 
+#include <limits>
+
 namespace Gauge {
 
 struct Transform;
 
-class AABB {
+// Stored as corners so growing and merging are plain component-wise min and
+// max. An empty box has min above max, which any merge replaces. Both corners
+// start on a 16 byte boundary so they load as whole vectors.
+class alignas(16) AABB {
    public:
-    Vec3 position{};
-    Vec3 extent{};
+    Vec3 min{std::numeric_limits<float>::infinity()};
 
-   protected:
-    bool valid = false;
+   private:
+    float min_padding = 0.0f;
 
    public:
-    bool IsPointInside(Vec3 p_point) const;
+    Vec3 max{-std::numeric_limits<float>::infinity()};
+
+   private:
+    float max_padding = 0.0f;
+
+   public:
+    inline bool IsValid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+
+    inline Vec3 GetMin() const { return min; }
+    inline Vec3 GetMax() const { return max; }
+    inline Vec3 GetCenter() const { return (min + max) * 0.5f; }
+    // Half the size
+    inline Vec3 GetExtent() const { return (max - min) * 0.5f; }
+    float GetSurfaceArea() const;
+    AABB Expanded(float p_margin) const;
+
     void Grow(Vec3 p_point);
-    void Grow(AABB p_other);
-    inline bool IsValid() { return valid; }
+    void Grow(const AABB& p_other);
+
+    bool IsPointInside(Vec3 p_point) const;
+    bool Contains(const AABB& p_other) const;
+    bool Intersects(const AABB& p_other) const;
+    bool IntersectsSphere(Vec3 p_center, float p_radius) const;
+    // Slab test against the ray origin + t * direction for t in [0, p_max_distance].
+    // Takes the reciprocal of the direction so it can be computed once per ray.
+    bool IntersectsRay(Vec3 p_origin, Vec3 p_inverse_direction, float p_max_distance, float& r_distance) const;
+
+    // Planes as normal and distance, with the inner side where
+    // dot(plane, Vec4(point, 1)) >= 0
+    bool IsOutsidePlane(const Vec4& p_plane) const;
+    bool IsInsidePlane(const Vec4& p_plane) const;
+
+    static AABB FromMinMax(Vec3 p_min, Vec3 p_max);
+    static AABB Merge(const AABB& p_a, const AABB& p_b);
 
     AABB() {}
-    AABB(Vec3 position, Vec3 extent) : position(position), extent(extent), valid(true) {}
+    AABB(Vec3 center, Vec3 extent) : min(center - extent), max(center + extent) {}
 };
 
 // From "Real-Time Collision Detection" by Christer Ericson, 4.2.6
 template <>
 const inline AABB Transform::operator*(AABB const& rhs) const {
-    AABB aabb(position, Vec3());
+    if (!rhs.IsValid()) {
+        return rhs;
+    }
+    const Vec3 center = rhs.GetCenter();
+    const Vec3 extent = rhs.GetExtent();
+    Vec3 result_center = position;
+    Vec3 result_extent{};
     Mat3 rotation_matrix = glm::toMat3(rotation);
     for (uint i = 0; i < 3; ++i) {
         for (uint j = 0; j < 3; ++j) {
-            aabb.position[i] += rotation_matrix[j][i] * rhs.position[j];
-            aabb.extent[i] += std::abs(rotation_matrix[j][i]) * rhs.extent[j];
+            result_center[i] += rotation_matrix[j][i] * center[j] * scale;
+            result_extent[i] += std::abs(rotation_matrix[j][i]) * extent[j];
         }
     }
-    aabb.position *= scale;
-    aabb.extent *= scale;
-    return aabb;
+    return AABB(result_center, result_extent * scale);
 }
 
 }  // namespace Gauge
\ No newline at end of file
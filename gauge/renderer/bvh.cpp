@@ -0,0 +1,214 @@
+#include "bvh.hpp"
+
+#include <algorithm>
+
+using namespace Gauge;
+
+uint BVH::AllocateNode() {
+    if (free_list == INVALID_INDEX) {
+        nodes.emplace_back();
+        return nodes.size() - 1;
+    }
+    const uint index = free_list;
+    free_list = nodes[index].parent;
+    nodes[index] = TreeNode{};
+    return index;
+}
+
+void BVH::FreeNode(uint p_index) {
+    nodes[p_index].parent = free_list;
+    nodes[p_index].height = -1;
+    free_list = p_index;
+}
+
+uint BVH::Insert(const AABB& p_aabb, uint p_user_data) {
+    const uint proxy = AllocateNode();
+    nodes[proxy].aabb = p_aabb.Expanded(MARGIN);
+    nodes[proxy].user_data = p_user_data;
+    nodes[proxy].height = 0;
+    InsertLeaf(proxy);
+    proxy_count++;
+    return proxy;
+}
+
+void BVH::Remove(uint p_proxy) {
+    assert(nodes[p_proxy].IsLeaf() && nodes[p_proxy].height == 0);
+    RemoveLeaf(p_proxy);
+    FreeNode(p_proxy);
+    proxy_count--;
+}
+
+bool BVH::Move(uint p_proxy, const AABB& p_aabb) {
+    // Leaves that grew too loose are reinserted as well, or a shrinking
+    // object would keep its old bounds forever
+    const AABB& fat_aabb = nodes[p_proxy].aabb;
+    if (fat_aabb.Contains(p_aabb) && p_aabb.Expanded(4.0f * MARGIN).Contains(fat_aabb)) {
+        return false;
+    }
+    RemoveLeaf(p_proxy);
+    nodes[p_proxy].aabb = p_aabb.Expanded(MARGIN);
+    InsertLeaf(p_proxy);
+    return true;
+}
+
+void BVH::Clear() {
+    nodes.clear();
+    root = INVALID_INDEX;
+    free_list = INVALID_INDEX;
+    proxy_count = 0;
+}
+
+void BVH::Refit(uint p_index) {
+    TreeNode& node = nodes[p_index];
+    const TreeNode& child_a = nodes[node.child_a];
+    const TreeNode& child_b = nodes[node.child_b];
+    node.aabb = AABB::Merge(child_a.aabb, child_b.aabb);
+    node.height = 1 + std::max(child_a.height, child_b.height);
+}
+
+void BVH::InsertLeaf(uint p_leaf) {
+    if (root == INVALID_INDEX) {
+        root = p_leaf;
+        nodes[root].parent = INVALID_INDEX;
+        return;
+    }
+
+    // Descend towards the sibling that adds the least surface area, counting
+    // the growth of every ancestor on the way
+    const AABB leaf_aabb = nodes[p_leaf].aabb;
+    uint index = root;
+    while (!nodes[index].IsLeaf()) {
+        const TreeNode& node = nodes[index];
+        const float area = node.aabb.GetSurfaceArea();
+        const float combined_area = AABB::Merge(node.aabb, leaf_aabb).GetSurfaceArea();
+
+        // Cost of making the leaf a sibling of this node
+        const float cost = 2.0f * combined_area;
+        // Minimum cost of pushing the leaf further down
+        const float inheritance_cost = 2.0f * (combined_area - area);
+
+        auto descend_cost = [&](uint p_child) {
+            const AABB& child_aabb = nodes[p_child].aabb;
+            const float merged_area = AABB::Merge(leaf_aabb, child_aabb).GetSurfaceArea();
+            if (nodes[p_child].IsLeaf()) {
+                return merged_area + inheritance_cost;
+            }
+            return merged_area - child_aabb.GetSurfaceArea() + inheritance_cost;
+        };
+        const float cost_a = descend_cost(node.child_a);
+        const float cost_b = descend_cost(node.child_b);
+
+        if (cost < cost_a && cost < cost_b) {
+            break;
+        }
+        index = cost_a < cost_b ? node.child_a : node.child_b;
+    }
+
+    const uint sibling = index;
+    const uint old_parent = nodes[sibling].parent;
+    const uint new_parent = AllocateNode();
+    nodes[new_parent].parent = old_parent;
+    nodes[new_parent].child_a = sibling;
+    nodes[new_parent].child_b = p_leaf;
+    nodes[sibling].parent = new_parent;
+    nodes[p_leaf].parent = new_parent;
+    if (old_parent == INVALID_INDEX) {
+        root = new_parent;
+    } else if (nodes[old_parent].child_a == sibling) {
+        nodes[old_parent].child_a = new_parent;
+    } else {
+        nodes[old_parent].child_b = new_parent;
+    }
+
+    for (index = new_parent; index != INVALID_INDEX; index = nodes[index].parent) {
+        Refit(index);
+        index = Balance(index);
+    }
+}
+
+void BVH::RemoveLeaf(uint p_leaf) {
+    if (p_leaf == root) {
+        root = INVALID_INDEX;
+        return;
+    }
+
+    const uint parent = nodes[p_leaf].parent;
+    const uint grandparent = nodes[parent].parent;
+    const uint sibling = nodes[parent].child_a == p_leaf ? nodes[parent].child_b : nodes[parent].child_a;
+
+    // The sibling takes the place of the parent
+    nodes[sibling].parent = grandparent;
+    FreeNode(parent);
+    if (grandparent == INVALID_INDEX) {
+        root = sibling;
+        return;
+    }
+    if (nodes[grandparent].child_a == parent) {
+        nodes[grandparent].child_a = sibling;
+    } else {
+        nodes[grandparent].child_b = sibling;
+    }
+
+    for (uint index = grandparent; index != INVALID_INDEX; index = nodes[index].parent) {
+        Refit(index);
+        index = Balance(index);
+    }
+}
+
+uint BVH::Balance(uint p_index) {
+    TreeNode& a = nodes[p_index];
+    if (a.IsLeaf() || a.height < 2) {
+        return p_index;
+    }
+
+    const uint index_b = a.child_a;
+    const uint index_c = a.child_b;
+    TreeNode& b = nodes[index_b];
+    TreeNode& c = nodes[index_c];
+    const int balance = c.height - b.height;
+
+    // Rotates p_up above A, A keeps p_kept and takes the lower of p_up's
+    // children, p_up keeps the higher one
+    auto rotate = [&](uint p_up, uint p_kept, bool p_up_is_a) {
+        TreeNode& up = nodes[p_up];
+        const uint index_f = up.child_a;
+        const uint index_g = up.child_b;
+        TreeNode& f = nodes[index_f];
+        TreeNode& g = nodes[index_g];
+
+        up.child_a = p_index;
+        up.parent = a.parent;
+        a.parent = p_up;
+        if (up.parent == INVALID_INDEX) {
+            root = p_up;
+        } else if (nodes[up.parent].child_a == p_index) {
+            nodes[up.parent].child_a = p_up;
+        } else {
+            nodes[up.parent].child_b = p_up;
+        }
+
+        const uint higher = f.height > g.height ? index_f : index_g;
+        const uint lower = f.height > g.height ? index_g : index_f;
+        up.child_b = higher;
+        if (p_up_is_a) {
+            a.child_a = lower;
+        } else {
+            a.child_b = lower;
+        }
+        nodes[lower].parent = p_index;
+
+        a.aabb = AABB::Merge(nodes[p_kept].aabb, nodes[lower].aabb);
+        a.height = 1 + std::max(nodes[p_kept].height, nodes[lower].height);
+        up.aabb = AABB::Merge(a.aabb, nodes[higher].aabb);
+        up.height = 1 + std::max(a.height, nodes[higher].height);
+        return p_up;
+    };
+
+    if (balance > 1) {
+        return rotate(index_c, index_b, false);
+    }
+    if (balance < -1) {
+        return rotate(index_b, index_c, true);
+    }
+    return p_index;
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <gauge/common.hpp>
+#include <gauge/renderer/aabb.hpp>
+#include <gauge/renderer/frustum.hpp>
+
+#include <cassert>
+#include <vector>
+
+namespace Gauge {
+
+// Dynamic bounding volume hierarchy, after the dynamic tree of Box2D. Leaves
+// store their bounds enlarged by a margin so that small movements don't
+// change the tree, larger ones remove and reinsert the leaf. Insertion picks
+// the sibling by the surface area heuristic and rotations keep the tree
+// balanced, so queries stay logarithmic no matter the insertion order.
+//
+// Proxies are indices of leaves and stay valid until removed. Queries report
+// the user data of every leaf whose enlarged bounds pass the test, callers
+// that need exact results test their own bounds again.
+class BVH {
+   public:
+    static constexpr uint INVALID_PROXY = ~0u;
+    static constexpr float MARGIN = 0.1f;
+
+   private:
+    static constexpr uint INVALID_INDEX = ~0u;
+    // Balancing keeps the height around 1.44 * log2(leaves), plenty of room
+    static constexpr uint STACK_SIZE = 128;
+
+    struct TreeNode {
+        AABB aabb;
+        // Next free node while on the free list
+        uint parent = INVALID_INDEX;
+        uint child_a = INVALID_INDEX;
+        uint child_b = INVALID_INDEX;
+        // 0 for leaves, -1 for free nodes
+        int height = -1;
+        uint user_data = 0;
+
+        inline bool IsLeaf() const { return child_a == INVALID_INDEX; }
+    };
+
+    std::vector<TreeNode> nodes;
+    uint root = INVALID_INDEX;
+    uint free_list = INVALID_INDEX;
+    uint proxy_count = 0;
+
+    uint AllocateNode();
+    void FreeNode(uint p_index);
+    void InsertLeaf(uint p_leaf);
+    void RemoveLeaf(uint p_leaf);
+    // Rotates p_index if its subtrees differ in height by more than one and
+    // returns the index now at its place
+    uint Balance(uint p_index);
+    void Refit(uint p_index);
+
+    template <typename F>
+    void VisitLeaves(uint p_index, F& p_callback) const {
+        uint stack[STACK_SIZE];
+        uint count = 0;
+        stack[count++] = p_index;
+        while (count > 0) {
+            const TreeNode& node = nodes[stack[--count]];
+            if (node.IsLeaf()) {
+                p_callback(node.user_data);
+                continue;
+            }
+            assert(count + 2 <= STACK_SIZE);
+            stack[count++] = node.child_a;
+            stack[count++] = node.child_b;
+        }
+    }
+
+    template <typename Test, typename F>
+    void Traverse(const Test& p_test, F& p_callback) const {
+        if (root == INVALID_INDEX) {
+            return;
+        }
+        uint stack[STACK_SIZE];
+        uint count = 0;
+        stack[count++] = root;
+        while (count > 0) {
+            const TreeNode& node = nodes[stack[--count]];
+            if (!p_test(node.aabb)) {
+                continue;
+            }
+            if (node.IsLeaf()) {
+                p_callback(node.user_data);
+                continue;
+            }
+            assert(count + 2 <= STACK_SIZE);
+            stack[count++] = node.child_a;
+            stack[count++] = node.child_b;
+        }
+    }
+
+   public:
+    uint Insert(const AABB& p_aabb, uint p_user_data);
+    void Remove(uint p_proxy);
+    // Updates the bounds of a proxy, returns whether it had to be reinserted
+    bool Move(uint p_proxy, const AABB& p_aabb);
+    void Clear();
+
+    const AABB& GetFatAABB(uint p_proxy) const { return nodes[p_proxy].aabb; }
+    uint GetUserData(uint p_proxy) const { return nodes[p_proxy].user_data; }
+    uint GetProxyCount() const { return proxy_count; }
+    uint GetHeight() const { return root == INVALID_INDEX ? 0 : nodes[root].height; }
+
+    // p_callback(uint user_data) for every leaf overlapping the box
+    template <typename F>
+    void Query(const AABB& p_aabb, F&& p_callback) const {
+        Traverse([&](const AABB& p_bounds) { return p_bounds.Intersects(p_aabb); }, p_callback);
+    }
+
+    // p_callback(uint user_data) for every leaf overlapping the sphere
+    template <typename F>
+    void QuerySphere(Vec3 p_center, float p_radius, F&& p_callback) const {
+        Traverse([&](const AABB& p_bounds) { return p_bounds.IntersectsSphere(p_center, p_radius); }, p_callback);
+    }
+
+    // p_callback(uint user_data) for every leaf inside or intersecting the
+    // frustum. Subtrees entirely inside are reported without further tests.
+    template <typename F>
+    void QueryFrustum(const Frustum& p_frustum, F&& p_callback) const {
+        if (root == INVALID_INDEX) {
+            return;
+        }
+        uint stack[STACK_SIZE];
+        uint count = 0;
+        stack[count++] = root;
+        while (count > 0) {
+            const uint index = stack[--count];
+            const TreeNode& node = nodes[index];
+            const Frustum::Result result = p_frustum.Classify(node.aabb);
+            if (result == Frustum::Result::OUTSIDE) {
+                continue;
+            }
+            if (result == Frustum::Result::INSIDE) {
+                VisitLeaves(index, p_callback);
+                continue;
+            }
+            if (node.IsLeaf()) {
+                p_callback(node.user_data);
+                continue;
+            }
+            assert(count + 2 <= STACK_SIZE);
+            stack[count++] = node.child_a;
+            stack[count++] = node.child_b;
+        }
+    }
+
+    // p_callback(uint user_data, float max_distance) for every leaf the ray
+    // hits within max_distance. It returns the distance to clip the ray to,
+    // the distance of a confirmed hit when looking for the closest one.
+    template <typename F>
+    void Raycast(Vec3 p_origin, Vec3 p_direction, float p_max_distance, F&& p_callback) const {
+        if (root == INVALID_INDEX) {
+            return;
+        }
+        const Vec3 inverse_direction = 1.0f / glm::vec3(p_direction);
+        float max_distance = p_max_distance;
+        uint stack[STACK_SIZE];
+        uint count = 0;
+        stack[count++] = root;
+        while (count > 0) {
+            const TreeNode& node = nodes[stack[--count]];
+            float distance;
+            if (!node.aabb.IntersectsRay(p_origin, inverse_direction, max_distance, distance)) {
+                continue;
+            }
+            if (node.IsLeaf()) {
+                max_distance = p_callback(node.user_data, max_distance);
+                continue;
+            }
+            assert(count + 2 <= STACK_SIZE);
+            stack[count++] = node.child_a;
+            stack[count++] = node.child_b;
+        }
+    }
+};
+
+}  // namespace Gauge
\ No newline at end of file
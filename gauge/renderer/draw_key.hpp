@@ -0,0 +1,42 @@
+#pragma once
+
+#include <gauge/common.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+namespace Gauge::DrawKey {
+
+// 64 bit keys that order the draws of a frame, most significant field first:
+//   opaque:         pass:2 | queue:6 | material:22 | mesh:22 | depth:12
+//   blended passes: pass:2 | inverted depth:16 | queue:6 | material:20 | mesh:20
+// Opaque draws are sorted by state and front to back within the same state,
+// blended ones back to front. The queue stands in for the pipeline.
+constexpr uint PASS_BITS = 2;
+constexpr uint QUEUE_BITS = 6;
+constexpr uint MAX_QUEUES = 1u << QUEUE_BITS;
+
+// Keeps the exponent and the top of the mantissa of a non-negative float,
+// which preserves the order with more precision close to the camera
+inline uint64_t QuantizeDepth(float p_depth, uint p_bits) {
+    return (std::bit_cast<uint32_t>(std::max(p_depth, 0.0f)) << 1) >> (32 - p_bits);
+}
+
+inline uint64_t Opaque(uint p_pass, uint p_queue, uint p_material, uint p_mesh, float p_depth) {
+    return (uint64_t(p_pass) << 62) |
+           (uint64_t(p_queue) << 56) |
+           (uint64_t(p_material & 0x3fffff) << 34) |
+           (uint64_t(p_mesh & 0x3fffff) << 12) |
+           QuantizeDepth(p_depth, 12);
+}
+
+inline uint64_t Blended(uint p_pass, uint p_queue, uint p_material, uint p_mesh, float p_depth) {
+    return (uint64_t(p_pass) << 62) |
+           ((0xffff - QuantizeDepth(p_depth, 16)) << 46) |
+           (uint64_t(p_queue) << 40) |
+           (uint64_t(p_material & 0xfffff) << 20) |
+           uint64_t(p_mesh & 0xfffff);
+}
+
+}  // namespace Gauge::DrawKey
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include "frustum.hpp"
+
+#include <gauge/renderer/aabb.hpp>
+
+using namespace Gauge;
+
+Frustum Frustum::FromMatrix(const Mat4& p_view_projection) {
+    const Mat4 transposed = glm::transpose(p_view_projection);
+    Frustum frustum;
+    frustum.planes = {
+        transposed[3] + transposed[0],
+        transposed[3] - transposed[0],
+        transposed[3] + transposed[1],
+        transposed[3] - transposed[1],
+        transposed[2],
+        transposed[3] - transposed[2],
+    };
+    for (Vec4& plane : frustum.planes) {
+        plane /= glm::length(glm::vec3(plane));
+    }
+    return frustum;
+}
+
+Frustum::Result Frustum::Classify(const AABB& p_aabb) const {
+    Result result = Result::INSIDE;
+    for (const Vec4& plane : planes) {
+        if (p_aabb.IsOutsidePlane(plane)) {
+            return Result::OUTSIDE;
+        }
+        if (result == Result::INSIDE && !p_aabb.IsInsidePlane(plane)) {
+            result = Result::INTERSECTS;
+        }
+    }
+    return result;
+}
\ No newline at end of file
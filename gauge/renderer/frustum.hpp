@@ -0,0 +1,30 @@
+#pragma once
+
+#include <gauge/math/common.hpp>
+
+#include <array>
+
+namespace Gauge {
+
+class AABB;
+
+// View frustum as six planes facing inwards, extracted from a view projection
+// matrix with a depth range of 0 to 1 (Gribb and Hartmann)
+struct Frustum {
+    enum class Result {
+        OUTSIDE,
+        INTERSECTS,
+        INSIDE,
+    };
+
+    // xyz is the normal, w the distance, so dot(plane, Vec4(point, 1)) >= 0
+    // holds for points on the inner side
+    std::array<Vec4, 6> planes;
+
+    Result Classify(const AABB& p_aabb) const;
+    bool IsVisible(const AABB& p_aabb) const { return Classify(p_aabb) != Result::OUTSIDE; }
+
+    static Frustum FromMatrix(const Mat4& p_view_projection);
+};
+
+}  // namespace Gauge
\ No newline at end of file
@@ -4,8 +4,10 @@
 #include <gauge/components/aabb_gizmo.hpp>
 #include <gauge/components/mesh_instance.hpp>
 #include <gauge/core/app.hpp>
+#include <gauge/core/filesystem.hpp>
 #include <gauge/core/handle.hpp>
 #include <gauge/core/resource_manager.hpp>
+#include <gauge/math/batch.hpp>
 #include <gauge/math/common.hpp>
 #include <gauge/renderer/common.hpp>
 #include <gauge/renderer/vulkan/renderer_vulkan.hpp>
@@ -22,7 +24,10 @@
 #include "thirdparty/stb/stb_image.h"
 
 #include <assert.h>
+#include <unistd.h>
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <memory>
 #include <print>
 #include <variant>
@@ -39,6 +44,48 @@ constexpr const char* UV = "TEXCOORD_0";
 constexpr const char* TANGENT = "TANGENT";
 }  // namespace Attribute
 
+// Feeds a memory-mapped file to fastgltf without copying it. simdjson reads up to
+// `padding` bytes past the end of the data, which is only safe while those bytes
+// are still inside the last mapped page, otherwise the tail is copied once.
+class MappedDataGetter final : public fastgltf::GltfDataGetter {
+    FileSystem::MappedFile file;
+    std::vector<std::byte> padded_copy;
+    size_t position = 0;
+
+   public:
+    explicit MappedDataGetter(FileSystem::MappedFile p_file) : file(std::move(p_file)) {}
+
+    void read(void* p_destination, std::size_t p_count) override {
+        std::memcpy(p_destination, file.Data() + position, p_count);
+        position += p_count;
+    }
+
+    fastgltf::span<std::byte> read(std::size_t p_count, std::size_t p_padding) override {
+        const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t mapped_size = (file.Size() + page_size - 1) & ~(page_size - 1);
+        std::byte* data = reinterpret_cast<std::byte*>(const_cast<char*>(file.Data())) + position;
+        if (position + p_count + p_padding > mapped_size) {
+            padded_copy.assign(p_count + p_padding, std::byte{0});
+            std::memcpy(padded_copy.data(), data, p_count);
+            data = padded_copy.data();
+        }
+        position += p_count;
+        return fastgltf::span<std::byte>(data, p_count);
+    }
+
+    void reset() override {
+        position = 0;
+    }
+
+    std::size_t bytesRead() override {
+        return position;
+    }
+
+    std::size_t totalSize() override {
+        return file.Size();
+    }
+};
+
 static Vec4 Vec4FromFastGLTF(fastgltf::math::nvec4 p_vector) {
     return Vec4(
         p_vector[0],
@@ -84,8 +131,10 @@ static void IteratePositions(const fastgltf::Asset& asset, const fastgltf::Primi
         accessor,
         [&](Vec3 position, size_t index) {
             primitive.vertices[index].position = position;
-            primitive.aabb.Grow(position);
         });
+    if (!primitive.vertices.empty()) {
+        primitive.aabb = Math::ComputeBounds(&primitive.vertices[0].position, primitive.vertices.size(), sizeof(Vertex));
+    }
 }
 
 static void IterateNormals(const fastgltf::Asset& asset, const fastgltf::Primitive& fg_primitive, glTF::Primitive& primitive) {
@@ -160,7 +209,7 @@ Result<> glTF::LoadTextures(const fastgltf::Asset& p_asset, const std::filesyste
             fastgltf::visitor{
                 [&](fastgltf::sources::URI& file_name) {
                     const auto file_path = StringID(p_path / file_name.uri.fspath());
-                    texture.data = ResourceManager::Load<Gauge::Texture>(file_path);
+                    texture.source = ResourceManager::LoadAsync<Gauge::Texture>(file_path);
                 },
                 [&](const fastgltf::sources::Array& array) {
                     std::println("Array!");
@@ -201,19 +250,16 @@ Result<> glTF::LoadTextures(const fastgltf::Asset& p_asset, const std::filesyste
 }
 
 Result<> glTF::LoadMaterials(const fastgltf::Asset& p_asset) {
-    auto renderer = static_cast<RendererVulkan*>(&(*gApp->renderer));
     materials.resize(p_asset.materials.size());
     for (uint i = 0; i < p_asset.materials.size(); ++i) {
         const fastgltf::Material& fg_material = p_asset.materials[i];
         glTF::Material& material = materials[i];
         material.name = fg_material.name;
         material.albedo = Vec4FromFastGLTF(fg_material.pbrData.baseColorFactor);
+        material.transparent = fg_material.alphaMode == fastgltf::AlphaMode::Blend;
 
         if (fg_material.name.starts_with("Gizmo")) {
             material.shader_id = "Gizmo"_id;
-            material.handle = renderer->CreateMaterial(GPU_BasicMaterial{
-                .color = material.albedo,
-            });
             continue;
         }
 
@@ -221,34 +267,15 @@ Result<> glTF::LoadMaterials(const fastgltf::Asset& p_asset) {
         material.metallic = fg_material.pbrData.metallicFactor;
         material.roughness = fg_material.pbrData.roughnessFactor;
 
-        GPU_PBRMaterial gpu_material{
-            .albedo = material.albedo,
-            .metallic = material.metallic,
-            .roughness = material.roughness,
-        };
         if (fg_material.pbrData.baseColorTexture.has_value()) {
             material.texture_albedo_index = fg_material.pbrData.baseColorTexture->textureIndex;
-            glTF::Texture& texture = textures[material.texture_albedo_index.value()];
-            texture.data->use_srgb = true;
-            if (texture.handle.index == 0) {
-                texture.handle = gApp->renderer->CreateTexture(*texture.data);
-            }
-            gpu_material.texture_albedo = texture.handle.index;
         }
         if (fg_material.normalTexture.has_value()) {
             material.texture_normal_index = fg_material.normalTexture->textureIndex;
-            glTF::Texture& texture = textures[material.texture_normal_index.value()];
-            texture.data->use_srgb = false;
-            if (texture.handle.index == 0) {
-                texture.handle = gApp->renderer->CreateTexture(*texture.data);
-            }
-            gpu_material.texture_normal = texture.handle.index;
         }
         if (fg_material.pbrData.metallicRoughnessTexture.has_value()) {
             material.texture_metallic_roughness_index = fg_material.pbrData.metallicRoughnessTexture->textureIndex;
         }
-
-        material.handle = renderer->CreateMaterial(gpu_material);
     }
     return {};
 }
@@ -271,7 +298,6 @@ Result<> glTF::LoadMeshes(const fastgltf::Asset& p_asset) {
             IterateTangents(p_asset, fg_primitive, primitive);
             IterateUVs(p_asset, fg_primitive, primitive);
 
-            primitive.handle = gApp->renderer->CreateMesh(primitive.vertices, primitive.indices);
             mesh.primitives.push_back(primitive);
             mesh.aabb.Grow(primitive.aabb);
         }
@@ -280,22 +306,45 @@ Result<> glTF::LoadMeshes(const fastgltf::Asset& p_asset) {
 }
 
 Result<glTF>
-glTF::FromFile(const std::string& p_path) {
+glTF::Parse(const std::string& p_path) {
     glTF gltf{};
 
     std::filesystem::path path(p_path);
     gltf.name = path.stem();
     fastgltf::Parser parser;
-    auto data = fastgltf::GltfDataBuffer::FromPath(path);
-    if (data.error() != fastgltf::Error::None) {
-        return Error(std::format("Could not load glTF file. fastgltf error: {}", fastgltf::getErrorMessage(data.error())));
+    auto file = FileSystem::Map(p_path);
+    if (!file) {
+        return Error(std::format("Could not load glTF file. {}", file.error()));
     }
+    MappedDataGetter data(std::move(file.value()));
 
-    auto asset = parser.loadGltf(data.get(), path.parent_path(), fastgltf::Options::LoadExternalBuffers);
+    auto asset = parser.loadGltf(data, path.parent_path(), fastgltf::Options::None);
     if (asset.error() != fastgltf::Error::None) {
         return Error(std::format("Could not parse glTF file. fastgltf error: {}", fastgltf::getErrorMessage(asset.error())));
     }
 
+    // External buffers are mapped through the FileSystem instead of letting fastgltf
+    // read them, so they can come from asset packs and are not copied. The vertex
+    // data is extracted below, so the mappings only need to outlive this function.
+    std::vector<FileSystem::MappedFile> external_buffers;
+    for (fastgltf::Buffer& buffer : asset->buffers) {
+        const auto* uri = std::get_if<fastgltf::sources::URI>(&buffer.data);
+        if (uri == nullptr || !uri->uri.isLocalPath()) {
+            continue;
+        }
+        const std::string buffer_path = (path.parent_path() / uri->uri.fspath()).string();
+        auto buffer_file = FileSystem::Map(buffer_path);
+        if (!buffer_file) {
+            return Error(std::format("Could not load glTF buffer. {}", buffer_file.error()));
+        }
+        const auto* bytes = reinterpret_cast<const std::byte*>(buffer_file->Data()) + uri->fileByteOffset;
+        buffer.data = fastgltf::sources::ByteView{
+            .bytes = fastgltf::span<const std::byte>(bytes, buffer.byteLength),
+            .mimeType = uri->mimeType,
+        };
+        external_buffers.emplace_back(std::move(buffer_file.value()));
+    }
+
     CHECK_RET(gltf.LoadNodes(asset.get())
                   .and_then([&gltf, &asset, &path]() {
                       return gltf.LoadTextures(asset.get(), path.parent_path());
@@ -305,19 +354,139 @@ glTF::FromFile(const std::string& p_path) {
                   })
                   .and_then([&gltf, &asset]() {
                       return gltf.LoadMeshes(asset.get());
-                  })
-                  .and_then([&gltf, &asset]() {
-                      return gltf.PostProcess(asset.get());
                   }));
     return gltf;
 }
 
+Result<glTF>
+glTF::FromFile(const std::string& p_path) {
+    auto gltf = Parse(p_path);
+    CHECK_RET(gltf);
+    CHECK_RET(gltf->Upload());
+    return gltf;
+}
+
+Result<uint> glTF::UploadTexture(uint p_index, bool p_srgb) {
+    glTF::Texture& texture = textures[p_index];
+    if (texture.data == nullptr) {
+        texture.data = texture.source.Wait();
+        if (texture.data == nullptr) {
+            return Error(std::format("Could not load texture {} of {}", p_index, name));
+        }
+    }
+    texture.data->use_srgb = p_srgb;
+    if (texture.handle.index == 0) {
+        texture.handle = gApp->renderer->CreateTexture(*texture.data);
+    }
+    return texture.handle.index;
+}
+
+Result<> glTF::UploadMaterials() {
+    auto renderer = static_cast<RendererVulkan*>(&(*gApp->renderer));
+    for (glTF::Material& material : materials) {
+        material.draw_queue = renderer->GetDrawQueue(material.shader_id, material.transparent);
+        if (material.shader_id == "Gizmo"_id) {
+            material.handle = renderer->CreateMaterial(GPU_BasicMaterial{
+                .color = material.albedo,
+            });
+            continue;
+        }
+
+        GPU_PBRMaterial gpu_material{
+            .albedo = material.albedo,
+            .metallic = material.metallic,
+            .roughness = material.roughness,
+        };
+        if (material.texture_albedo_index.has_value()) {
+            auto texture_index = UploadTexture(material.texture_albedo_index.value(), true);
+            CHECK_RET(texture_index);
+            gpu_material.texture_albedo = texture_index.value();
+        }
+        if (material.texture_normal_index.has_value()) {
+            auto texture_index = UploadTexture(material.texture_normal_index.value(), false);
+            CHECK_RET(texture_index);
+            gpu_material.texture_normal = texture_index.value();
+        }
+
+        material.handle = renderer->CreateMaterial(gpu_material);
+    }
+    return {};
+}
+
+Result<> glTF::UploadMeshes() {
+    for (glTF::Mesh& mesh : meshes) {
+        for (glTF::Primitive& primitive : mesh.primitives) {
+            primitive.handle = gApp->renderer->CreateMesh(primitive.vertices, primitive.indices);
+        }
+    }
+    return {};
+}
+
+Result<> glTF::Upload() {
+    return UploadMaterials()
+        .and_then([this]() {
+            return UploadMeshes();
+        })
+        .and_then([this]() {
+            return PostProcess();
+        });
+}
+
+bool glTF::IsReadyToUpload() const {
+    return std::ranges::all_of(textures, [](const glTF::Texture& p_texture) {
+        return !p_texture.source.IsValid() || p_texture.source.IsReady();
+    });
+}
+
+size_t glTF::GetSize() const {
+    size_t size = sizeof(glTF);
+    for (const glTF::Mesh& mesh : meshes) {
+        for (const glTF::Primitive& primitive : mesh.primitives) {
+            // The vertices are kept on the CPU for collision shapes, so they count twice
+            size += 2 * (primitive.vertices.size() * sizeof(Vertex) + primitive.indices.size() * sizeof(uint));
+        }
+    }
+    // Pixel data is owned by the texture resources, only the GPU images are ours
+    for (const glTF::Texture& texture : textures) {
+        if (texture.handle.index != 0 && texture.data != nullptr) {
+            size += texture.data->GetSize();
+        }
+    }
+    return size;
+}
+
+void glTF::Unload() {
+    Renderer& renderer = *gApp->renderer;
+    for (glTF::Mesh& mesh : meshes) {
+        for (glTF::Primitive& primitive : mesh.primitives) {
+            renderer.DestroyMesh(primitive.handle);
+            primitive.handle = {};
+        }
+    }
+    for (glTF::Material& material : materials) {
+        renderer.DestroyMaterial(material.handle);
+        material.handle = {};
+    }
+    for (glTF::Texture& texture : textures) {
+        // Index 0 is the renderer's own texture, see UploadTexture
+        if (texture.handle.index != 0) {
+            renderer.DestroyTexture(texture.handle);
+            texture.handle = {};
+        }
+        if (texture.source.IsValid()) {
+            ResourceManager::Unreference<Gauge::Texture>(texture.source.GetID());
+            texture.source = {};
+        }
+        texture.data = nullptr;
+    }
+}
+
 Result<Ref<Gauge::Node>> glTF::CreateNode() const {
     std::vector<Ref<Gauge::Node>> instanced_nodes;
     instanced_nodes.resize(nodes.size());
     for (uint i = 0; i < nodes.size(); ++i) {
         instanced_nodes[i] = Gauge::Node::Create(nodes[i].name);
-        instanced_nodes[i]->local_transform = nodes[i].transform;
+        instanced_nodes[i]->SetTransform(nodes[i].transform);
         AABB aabb;
         if (nodes[i].mesh.has_value()) {
             const glTF::Mesh& mesh = meshes[nodes[i].mesh.value()];
@@ -327,7 +496,7 @@ Result<Ref<Gauge::Node>> glTF::CreateNode() const {
                 mesh_component->surfaces.emplace_back(MeshInstance::Surface{
                     .primitive = primitive.handle,
                     .material = material.handle,
-                    .shader_id = material.shader_id,
+                    .draw_queue = material.draw_queue,
                 });
             }
 
@@ -368,7 +537,7 @@ Result<Ref<Gauge::Node>> glTF::CreateNode() const {
             Ref<Gauge::Node> child = node;
             node = node->parent.lock();
             if (child->aabb.IsValid()) {
-                node->aabb.Grow(child->local_transform * child->aabb);
+                node->aabb.Grow(child->GetTransform() * child->aabb);
             }
         }
     }
@@ -381,7 +550,7 @@ Result<Ref<Gauge::Node>> glTF::CreateNode() const {
     return root_node;
 }
 
-Result<> glTF::PostProcess(const fastgltf::Asset& p_asset) {
+Result<> glTF::PostProcess() {
     for (auto& node : nodes) {
         if (!node.name.ends_with("_col") || !node.mesh.has_value())
             continue;
@@ -2,6 +2,7 @@
 
 #include <gauge/common.hpp>
 #include <gauge/core/handle.hpp>
+#include <gauge/core/resource_manager.hpp>
 #include <gauge/math/common.hpp>
 #include <gauge/math/transform.hpp>
 #include <gauge/renderer/aabb.hpp>
@@ -36,6 +37,7 @@ struct glTF {
     struct Texture {
         Handle<GPUImage> handle{};
         std::string name;
+        ResourceManager::Future<Gauge::Texture> source;
         Gauge::Texture* data{};
     };
 
@@ -49,6 +51,9 @@ struct glTF {
         std::optional<uint> texture_normal_index;
         std::optional<uint> texture_metallic_roughness_index;
         StringID shader_id;
+        // Alpha blended, drawn back to front after the opaque pass
+        bool transparent{};
+        uint draw_queue{};
     };
 
     struct Primitive {
@@ -77,18 +82,33 @@ struct glTF {
     Result<> LoadTextures(const fastgltf::Asset& p_asset, const std::filesystem::path& p_path = std::filesystem::path());
     Result<> LoadMaterials(const fastgltf::Asset& p_asset);
     Result<> LoadMeshes(const fastgltf::Asset& p_asset);
-    Result<> PostProcess(const fastgltf::Asset& p_asset);
+
+    Result<uint> UploadTexture(uint p_index, bool p_srgb);
+    Result<> UploadMaterials();
+    Result<> UploadMeshes();
+    Result<> PostProcess();
 
    public:
+    // CPU side of loading, safe to call from worker threads
+    static Result<glTF> Parse(const std::string& p_path);
+    // Creates GPU objects and collision shapes, render thread only
+    Result<> Upload();
     static Result<glTF> FromFile(const std::string& p_path);
     Result<Ref<Gauge::Node>> CreateNode() const;
+    // Approximate CPU and GPU memory held by the loaded data, used by the resource cache
+    size_t GetSize() const;
+    // False while textures it references are still loading
+    bool IsReadyToUpload() const;
 
     // --- Resource interface ---
     static glTF Load(StringID p_id) {
         return FromFile(p_id).value();
     }
-    void Unload() {
+    static Result<glTF> Prepare(StringID p_id) {
+        return Parse(p_id);
     }
+    // Frees the GPU objects created by Upload and drops the textures' references
+    void Unload();
 };
 
 }  // namespace Gauge
\ No newline at end of file
@@ -58,10 +58,14 @@ void BillboardShader::Draw(RendererVulkan& renderer, const CommandBufferVulkan&
         pcs.material = *renderer.resources.materials.Get(object.material);
         pcs.node_handle = object.node_handle;
         vkCmdPushConstants(cmd.GetHandle(), pipeline.layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(BillboardShader::PushConstants), &pcs);
-        vkCmdDraw(cmd.GetHandle(), 6, 1, 0, 0);
+        cmd.Draw(6);
     }
 }
 
+void BillboardShader::BeginFrame(FrameArena& p_arena) {
+    objects = ArenaVector<DrawObject>(p_arena);
+}
+
 void BillboardShader::Clear() {
     objects.clear();
 }
\ No newline at end of file
@@ -2,7 +2,6 @@
 
 #include <gauge/renderer/shaders/shader.hpp>
 
-#include <vector>
 
 namespace Gauge {
 
@@ -13,21 +12,22 @@ class BillboardShader : public Shader {
         uint camera_index;
         Vec2 size;
         GPUMaterial material;
-        uint node_handle;
+        uint64_t node_handle;
     };
 
     struct DrawObject {
         Handle<GPUMaterial> material;
         Vec3 world_position;
         Vec2 size;
-        uint node_handle;
+        uint64_t node_handle;
     };
 
-    std::vector<DrawObject> objects;
+    ArenaVector<DrawObject> objects;
 
    public:
     virtual void Initialize(const RendererVulkan& renderer) override;
     virtual void Draw(RendererVulkan& renderer, const CommandBufferVulkan& cmd) const override;
+    virtual void BeginFrame(FrameArena& p_arena) override;
     virtual void Clear() override;
 
     BillboardShader() {}
@@ -51,17 +51,21 @@ void DebugLineShader::Draw(RendererVulkan& renderer, const CommandBufferVulkan&
     pcs.camera_index = 0;
 
     cmd.BindPipeline(pipeline);
+    cmd.BindIndexBuffer(renderer.resources.indices.buffer.handle);
     for (const DrawObject& object : objects) {
         auto mesh = renderer.resources.meshes.Get(object.mesh);
-        pcs.vertex_buffer_address = mesh->vertex_buffer.address;
+        pcs.vertex_buffer_address = renderer.GetVertexAddress(*mesh);
         pcs.model_matrix = object.transform;
         pcs.color = object.color;
         vkCmdPushConstants(cmd.GetHandle(), pipeline.layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushConstants), &pcs);
-        vkCmdBindIndexBuffer(cmd.GetHandle(), mesh->index_buffer.handle, 0, VK_INDEX_TYPE_UINT32);
-        vkCmdDrawIndexed(cmd.GetHandle(), mesh->index_count, 1, 0, 0, 0);
+        cmd.DrawIndexed(mesh->index_count, mesh->first_index);
     }
 }
 
+void DebugLineShader::BeginFrame(FrameArena& p_arena) {
+    objects = ArenaVector<DrawObject>(p_arena);
+}
+
 void DebugLineShader::Clear() {
     objects.clear();
 }
\ No newline at end of file
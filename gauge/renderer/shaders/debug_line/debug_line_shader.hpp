@@ -3,7 +3,6 @@
 #include <gauge/renderer/aabb.hpp>
 #include <gauge/renderer/shaders/shader.hpp>
 
-#include <vector>
 
 namespace Gauge {
 
@@ -22,11 +21,12 @@ class DebugLineShader : public Shader {
         Vec4 color;
     };
 
-    std::vector<DrawObject> objects;
+    ArenaVector<DrawObject> objects;
 
    public:
     virtual void Initialize(const RendererVulkan& renderer) override;
     virtual void Draw(RendererVulkan& renderer, const CommandBufferVulkan& cmd) const override;
+    virtual void BeginFrame(FrameArena& p_arena) override;
     virtual void Clear() override;
 
     DebugLineShader() {}
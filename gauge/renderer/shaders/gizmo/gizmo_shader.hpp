@@ -1,11 +1,10 @@
 #pragma once
 
-#include <gauge/renderer/shaders/shader.hpp>
-#include <vector>
+#include <gauge/renderer/shaders/mesh_shader.hpp>
 
 namespace Gauge {
 
-class GizmoShader : public Shader {
+class GizmoShader : public MeshShader {
    public:
     enum class State {
         NONE,
@@ -13,28 +12,9 @@ class GizmoShader : public Shader {
         CLICKED,
     };
 
-    struct PushConstants {
-        Mat4 model_matrix;
-        VkDeviceAddress vertex_buffer_address;
-        GPUMaterial material;
-        uint camera_id;
-        uint node_handle;
-    };
-
-    struct DrawObject {
-        Handle<GPUMesh> primitive;
-        Handle<GPUMaterial> material;
-        Transform transform;
-        uint node_handle;
-        Vec3 color;
-    };
-
-    std::vector<DrawObject> objects;
-
    public:
     virtual void Initialize(const RendererVulkan& renderer) override;
-    virtual void Draw(RendererVulkan& renderer, const CommandBufferVulkan& cmd) const override;
-    virtual void Clear() override;
+    virtual Pass GetPass(bool p_transparent) const override { return Pass::OVERLAY; }
 
     GizmoShader() {}
     ~GizmoShader() {}
@@ -1,3 +1,5 @@
 #define MAX_CAMERAS 16
 #define MAX_SCENES 16
-#define MAX_POINT_LIGHTS 16
\ No newline at end of file
+#define MAX_POINT_LIGHTS 16
+// Per frame, the draw buffers grow when a frame needs more
+#define INITIAL_DRAW_OBJECTS 65536
\ No newline at end of file
@@ -0,0 +1,38 @@
+#include "mesh_shader.hpp"
+
+#include <gauge/renderer/vulkan/renderer_vulkan.hpp>
+
+using namespace Gauge;
+
+void MeshShader::Reload(const RendererVulkan& renderer) {
+    vkDeviceWaitIdle(renderer.ctx.device);
+    vkDestroyPipeline(renderer.ctx.device, transparent_pipeline.handle, nullptr);
+    vkDestroyPipelineLayout(renderer.ctx.device, transparent_pipeline.layout, nullptr);
+    Shader::Reload(renderer);
+}
+
+void MeshShader::Bind(RendererVulkan& renderer, const CommandBufferVulkan& cmd, Pass p_pass, uint p_camera_id) const {
+    const Pipeline& pass_pipeline = p_pass == Pass::TRANSPARENT ? transparent_pipeline : pipeline;
+    const VkDescriptorSet sets[] = {
+        renderer.global_descriptor.set.handle,
+        renderer.GetCurrentFrame().descriptor_set.handle,
+    };
+    vkCmdBindDescriptorSets(
+        cmd.GetHandle(),
+        VK_PIPELINE_BIND_POINT_GRAPHICS,
+        pass_pipeline.layout,
+        0,
+        2,
+        sets,
+        0,
+        nullptr);
+    cmd.BindPipeline(pass_pipeline);
+
+    const RendererVulkan::FrameData& frame = renderer.GetCurrentFrame();
+    const PushConstants pcs{
+        .draw_objects = frame.draw_object_buffer.address,
+        .draw_instances = frame.draw_instance_buffer.address,
+        .camera_id = p_camera_id,
+    };
+    vkCmdPushConstants(cmd.GetHandle(), pass_pipeline.layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushConstants), &pcs);
+}
\ No newline at end of file
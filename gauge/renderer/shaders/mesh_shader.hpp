@@ -0,0 +1,58 @@
+#pragma once
+
+#include <gauge/renderer/shaders/shader.hpp>
+
+namespace Gauge {
+
+// Shader drawing mesh surfaces. The renderer gives each of its passes a draw
+// queue index, which surfaces resolve from the shader id once when they are
+// created, so submitting a surface is a single append.
+//
+// Drawing is GPU driven and done by the renderer rather than the shader: the
+// objects of all queues are sorted by draw key, written to the frame's draw
+// object buffer grouped by mesh and material, and culled by a compute pass.
+// Every group with visible objects becomes one instanced indirect command,
+// and consecutive groups of a mesh are drawn with one indirect draw whose
+// count the culling pass wrote.
+class MeshShader : public Shader {
+   public:
+    enum class Pass : uint8_t {
+        OPAQUE,
+        // Blended, drawn back to front after the opaque pass
+        TRANSPARENT,
+        // Drawn on top of everything, back to front
+        OVERLAY,
+    };
+
+    struct DrawObject {
+        Handle<GPUMesh> primitive;
+        Handle<GPUMaterial> material;
+        Transform transform;
+        uint64_t node_handle;
+    };
+
+    struct PushConstants {
+        VkDeviceAddress draw_objects;
+        VkDeviceAddress draw_instances;
+        uint camera_id;
+    };
+
+    // Used by the transparent pass, blends and doesn't write depth
+    Pipeline transparent_pipeline{};
+    // Off for shaders that don't draw objects within their mesh's bounds
+    bool cull = true;
+
+   public:
+    // Drawn by the renderer in draw key order
+    virtual void Draw(RendererVulkan& renderer, const CommandBufferVulkan& cmd) const override {}
+    virtual void BeginFrame(FrameArena& p_arena) override {}
+    virtual void Clear() override {}
+    virtual void Reload(const RendererVulkan& renderer) override;
+
+    // Pass of surfaces with opaque or blended materials
+    virtual Pass GetPass(bool p_transparent) const { return p_transparent ? Pass::TRANSPARENT : Pass::OPAQUE; }
+    // Binds the pass's pipeline, the descriptor sets and the push constants
+    void Bind(RendererVulkan& renderer, const CommandBufferVulkan& cmd, Pass p_pass, uint p_camera_id) const;
+};
+
+}  // namespace Gauge
\ No newline at end of file
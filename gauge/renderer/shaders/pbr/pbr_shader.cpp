@@ -25,42 +25,12 @@ void PBRShader::Initialize(const RendererVulkan& renderer) {
             .AddDescriptorSetLayout(renderer.global_descriptor.layout)
             .AddDescriptorSetLayout(renderer.frames_in_flight[0].descriptor_set.GetLayout())
             .AddPushConstantRange(VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, sizeof(PushConstants))
-            .SetTransparency(true)
             .SetImageFormat(renderer.offscreen ? VK_FORMAT_R8G8B8A8_SRGB : renderer.swapchain.image_format)
             .SetSampleCount(RendererVulkan::SampleCountFromMSAA(gApp->project_settings.msaa_level));
     pipeline = builder.Build(renderer).value();
-}
-
-void PBRShader::Draw(RendererVulkan& renderer, const CommandBufferVulkan& cmd) const {
-    const VkDescriptorSet sets[] = {
-        renderer.global_descriptor.set.handle,
-        renderer.GetCurrentFrame().descriptor_set.handle,
-    };
-    vkCmdBindDescriptorSets(
-        cmd.GetHandle(),
-        VK_PIPELINE_BIND_POINT_GRAPHICS,
-        pipeline.layout,
-        0,
-        2,
-        sets,
-        0,
-        nullptr);
-
-    PushConstants pcs;
-    pcs.camera_id = 0;
-    cmd.BindPipeline(pipeline);
-    for (const DrawObject& object : objects) {
-        pcs.model_matrix = object.transform.GetMatrix();
-        pcs.material = *renderer.resources.materials.Get(object.material);
-        const GPUMesh& mesh = *renderer.resources.meshes.Get(object.primitive);
-        pcs.vertex_buffer_address = mesh.vertex_buffer.address;
-        pcs.node_handle = object.node_handle;
-        vkCmdPushConstants(cmd.GetHandle(), pipeline.layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushConstants), &pcs);
-        vkCmdBindIndexBuffer(cmd.GetHandle(), mesh.index_buffer.handle, 0, VK_INDEX_TYPE_UINT32);
-        vkCmdDrawIndexed(cmd.GetHandle(), mesh.index_count, 1, 0, 0, 0);
-    }
-}
-
-void PBRShader::Clear() {
-    objects.clear();
+    transparent_pipeline = GraphicsPipelineBuilder(builder)
+                               .SetTransparency(true)
+                               .EnableDepthWrite(false)
+                               .Build(renderer)
+                               .value();
 }
\ No newline at end of file
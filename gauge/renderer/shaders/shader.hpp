@@ -1,5 +1,6 @@
 #pragma once
 
+#include <gauge/core/frame_arena.hpp>
 #include <gauge/core/string_id.hpp>
 #include <gauge/renderer/vulkan/common.hpp>
 #include <gauge/renderer/vulkan/graphics_pipeline_builder.hpp>
@@ -19,9 +20,12 @@ class Shader {
    public:
     virtual void Initialize(const RendererVulkan& renderer) = 0;
     virtual void Draw(RendererVulkan& renderer, const CommandBufferVulkan& cmd) const = 0;
+    // Binds the draw lists to the arena of the frame being recorded
+    virtual void BeginFrame(FrameArena& p_arena) = 0;
+    // Empties the draw lists before each viewport
     virtual void Clear() = 0;
 
-    void Reload(const RendererVulkan& renderer);
+    virtual void Reload(const RendererVulkan& renderer);
 
     Shader() {}
     virtual ~Shader() {}
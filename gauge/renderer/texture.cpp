@@ -1,5 +1,7 @@
 #include "texture.hpp"
 
+#include <gauge/core/filesystem.hpp>
+
 #include <filesystem>
 #include <format>
 #include <print>
@@ -17,7 +19,7 @@ Result<Texture> Texture::FromFile(const std::string& p_path) {
     std::filesystem::path path(p_path);
     auto ktx_path = path;
     ktx_path.replace_extension("ktx2");
-    if (std::filesystem::exists(ktx_path)) {
+    if (FileSystem::Exists(ktx_path)) {
         return Texture::LoadKTX(ktx_path);
     }
     return LoadSTB(path);
@@ -25,9 +27,11 @@ Result<Texture> Texture::FromFile(const std::string& p_path) {
 
 Result<Texture> Texture::LoadKTX(const std::filesystem::path p_path) {
     std::println("Loading ktx2 file: {}", p_path.c_str());
+    auto file = FileSystem::Map(p_path);
+    CHECK_RET(file);
     Texture texture{};
     texture.ktx_texture = new ktxTexture2;
-    auto result = ktxTexture2_CreateFromNamedFile(p_path.c_str(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &texture.ktx_texture);
+    auto result = ktxTexture2_CreateFromMemory(reinterpret_cast<const ktx_uint8_t*>(file->Data()), file->Size(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &texture.ktx_texture);
     if (result != KTX_SUCCESS) {
         return Error(std::format("Could not load KTX texture {}. Error: {}", p_path.c_str(), ktxErrorString(result)));
     }
@@ -52,9 +56,12 @@ Result<Texture> Texture::LoadKTX(const std::filesystem::path p_path) {
 }
 
 Result<Texture> Texture::LoadSTB(const std::filesystem::path p_path) {
+    auto file = FileSystem::Map(p_path);
+    CHECK_RET(file);
+
     Texture texture{};
     int width, height, number_channels;
-    texture.data = stbi_load(p_path.c_str(), &width, &height, &number_channels, 4);
+    texture.data = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(file->Data()), static_cast<int>(file->Size()), &width, &height, &number_channels, 4);
     if (!texture.data) {
         return Error(std::format("Could not load image file '{}'", p_path.c_str()));
     }
@@ -72,4 +79,16 @@ Texture::~Texture() {
             // ktxTexture2_Destroy(ktx_texture);
         }
     }
+}
+
+void Texture::Unload() {
+    // Copies share the pixel data, only the one owned by the resource manager frees it
+    if (ktx_texture != nullptr) {
+        ktxTexture2_Destroy(ktx_texture);
+        ktx_texture = nullptr;
+    }
+    if (data != nullptr) {
+        stbi_image_free(data);
+        data = nullptr;
+    }
 }
\ No newline at end of file
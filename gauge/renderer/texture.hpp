@@ -33,6 +33,13 @@ struct Texture {
         CHECK(result);
         return result.value();
     }
+    static Result<Texture> Prepare(StringID p_id) {
+        return FromFile(p_id);
+    }
+    Result<> Upload() {
+        // GPU images are created by their users, see glTF::UploadTexture
+        return {};
+    }
     void Unload();
 };
 
@@ -26,8 +26,9 @@ CommandBufferVulkan::End() {
     return {};
 }
 
-CommandBufferVulkan::CommandBufferVulkan(VkCommandBuffer p_cmd) {
+CommandBufferVulkan::CommandBufferVulkan(VkCommandBuffer p_cmd, DrawStats* p_stats) {
     cmd = p_cmd;
+    stats = p_stats;
 }
 
 void CommandBufferVulkan::TransitionImage(VkImage p_image, VkImageLayout p_current_layout, VkImageLayout p_target_layout, VkImageAspectFlags p_aspect_flags) const {
@@ -111,4 +112,35 @@ VkCommandBuffer CommandBufferVulkan::GetHandle() const {
 
 void CommandBufferVulkan::BindPipeline(const Pipeline& p_pipeline) const {
     vkCmdBindPipeline(cmd, p_pipeline.bind_point, p_pipeline.handle);
+    if (stats != nullptr && p_pipeline.bind_point == VK_PIPELINE_BIND_POINT_GRAPHICS) {
+        stats->pipeline_binds++;
+    }
+}
+
+void CommandBufferVulkan::BindIndexBuffer(VkBuffer p_buffer, VkIndexType p_index_type) const {
+    vkCmdBindIndexBuffer(cmd, p_buffer, 0, p_index_type);
+    if (stats != nullptr) {
+        stats->index_buffer_binds++;
+    }
+}
+
+void CommandBufferVulkan::Draw(uint p_vertex_count, uint p_first_vertex) const {
+    vkCmdDraw(cmd, p_vertex_count, 1, p_first_vertex, 0);
+    if (stats != nullptr) {
+        stats->draws++;
+    }
+}
+
+void CommandBufferVulkan::DrawIndexed(uint p_index_count, uint p_first_index, int p_vertex_offset) const {
+    vkCmdDrawIndexed(cmd, p_index_count, 1, p_first_index, p_vertex_offset, 0);
+    if (stats != nullptr) {
+        stats->draws++;
+    }
+}
+
+void CommandBufferVulkan::DrawIndexedIndirectCount(VkBuffer p_buffer, VkDeviceSize p_offset, VkBuffer p_count_buffer, VkDeviceSize p_count_offset, uint p_max_count) const {
+    vkCmdDrawIndexedIndirectCount(cmd, p_buffer, p_offset, p_count_buffer, p_count_offset, p_max_count, sizeof(VkDrawIndexedIndirectCommand));
+    if (stats != nullptr) {
+        stats->draws++;
+    }
 }
\ No newline at end of file
@@ -7,9 +7,19 @@
 #include <volk.h>
 
 namespace Gauge {
+// Graphics commands recorded through command buffers that count into it
+struct DrawStats {
+    uint pipeline_binds = 0;
+    uint index_buffer_binds = 0;
+    uint draws = 0;
+    // Objects that did not fit the draw buffers, only if growing them failed
+    uint dropped_objects = 0;
+};
+
 struct CommandBufferVulkan final : public CommandBuffer {
    private:
     VkCommandBuffer cmd;
+    DrawStats* stats{};
 
    public:
     Result<> Begin() final override;
@@ -18,7 +28,12 @@ struct CommandBufferVulkan final : public CommandBuffer {
     void TransitionImage(VkImage p_image, VkImageLayout p_current_layout, VkImageLayout p_target_layout, VkImageAspectFlags p_aspect_flags = VK_IMAGE_ASPECT_NONE) const;
     VkCommandBuffer GetHandle() const;
     void BindPipeline(const Pipeline& p_pipeline) const;
+    void BindIndexBuffer(VkBuffer p_buffer, VkIndexType p_index_type = VK_INDEX_TYPE_UINT32) const;
+    void Draw(uint p_vertex_count, uint p_first_vertex = 0) const;
+    void DrawIndexed(uint p_index_count, uint p_first_index, int p_vertex_offset = 0) const;
+    void DrawIndexedIndirectCount(VkBuffer p_buffer, VkDeviceSize p_offset, VkBuffer p_count_buffer, VkDeviceSize p_count_offset, uint p_max_count) const;
 
-    CommandBufferVulkan(VkCommandBuffer cmd);
+    // Commands are counted into p_stats if given
+    CommandBufferVulkan(VkCommandBuffer cmd, DrawStats* p_stats = nullptr);
 };
 }  // namespace Gauge
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <gauge/renderer/shaders/limits.h>
 #include <gauge/math/common.hpp>
 #include <gauge/math/transform.hpp>
+#include <gauge/renderer/aabb.hpp>
 #include <gauge/renderer/common.hpp>
 
 #define VK_NO_PROTOTYPES 1
@@ -49,10 +50,16 @@ struct GPUBuffer {
     void* mapped{};
 };
 
+// Ranges of the renderer's shared vertex and index buffers. Indices are
+// relative to the mesh's first vertex.
 struct GPUMesh {
     uint index_count;
-    GPUBuffer index_buffer{};
-    GPUBuffer vertex_buffer{};
+    uint first_index;
+    // In bytes
+    VkDeviceSize vertex_offset;
+    VkDeviceSize vertex_size;
+    // Of the vertex positions, used for culling on the GPU
+    AABB bounds{};
 };
 
 struct GPUImage {
@@ -61,6 +68,8 @@ struct GPUImage {
     VkFormat format{};
     VkExtent3D extent{};
     Allocation allocation{};
+    // Set for images that libktx allocated outside of VMA
+    VkDeviceMemory memory{};
     int file_descriptor{};
 };
 
@@ -70,6 +79,7 @@ struct GPUCamera {
     Mat4 inverse_projection;
     Vec2 pixel_size;
     Vec2 _padding0;
+    Vec4 frustum_planes[6];
 };
 
 struct GPUPointLight {
@@ -89,6 +99,51 @@ struct GPUScene {
     GPUPointLight point_lights[MAX_POINT_LIGHTS];
 };
 
+// Per object data of GPU driven draws. The culling pass appends the index of
+// every visible object to its group's range of the instance buffer.
+struct GPUDrawObject {
+    Mat4 model_matrix;
+    Vec3 bounds_min;
+    uint group;
+    Vec3 bounds_max;
+    uint _padding0;
+    VkDeviceAddress vertex_buffer_address;
+    // Handle::ToUint of the node, read as a uint2 by the shaders
+    uint64_t node_handle;
+    GPUMaterial material;
+    uint _padding1;
+    uint _padding2;
+};
+
+// Nodes under the mouse cursor, written by the fragment shaders. The first
+// entry only holds the number of entries that follow.
+struct GPUReadback {
+    uint count;
+    float depth;
+    uint64_t node_handle;
+};
+
+// Objects sharing a mesh and material, drawn as the instances of a single
+// indirect command if any of them are visible
+struct GPUDrawGroup {
+    // Appends the group's command after those of the batch's other visible
+    // groups, in no particular order
+    static constexpr uint APPEND_COMMAND = ~0u;
+
+    uint index_count;
+    // Into the shared index buffer
+    uint first_index;
+    // Into the frame's instance buffer
+    uint first_instance;
+    // Index of the batch's draw count
+    uint batch;
+    // First indirect command of the batch
+    uint first_command;
+    // Within the batch, for groups that have to stay in order. The command
+    // is written even without visible instances.
+    uint command;
+};
+
 struct GPUGlobals {
     float time;
     struct MousePosition {
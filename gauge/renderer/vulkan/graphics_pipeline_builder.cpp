@@ -64,6 +64,11 @@ GraphicsPipelineBuilder& GraphicsPipelineBuilder::EnableDepthTest(bool p_enabled
     return *this;
 }
 
+GraphicsPipelineBuilder& GraphicsPipelineBuilder::EnableDepthWrite(bool p_enabled) {
+    depth_write_enabled = p_enabled;
+    return *this;
+}
+
 Result<Pipeline>
 GraphicsPipelineBuilder::Build(const RendererVulkan& renderer) const {
     const VulkanContext& ctx = renderer.ctx;
@@ -140,7 +145,7 @@ GraphicsPipelineBuilder::Build(const RendererVulkan& renderer) const {
     const VkPipelineDepthStencilStateCreateInfo depth_state_info{
         .sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
         .depthTestEnable = depth_test_enabled ? VK_TRUE : VK_FALSE,
-        .depthWriteEnable = depth_test_enabled ? VK_TRUE : VK_FALSE,
+        .depthWriteEnable = depth_test_enabled && depth_write_enabled ? VK_TRUE : VK_FALSE,
         .depthCompareOp = depth_test_enabled ? VK_COMPARE_OP_GREATER_OR_EQUAL : VK_COMPARE_OP_ALWAYS,
     };
 
@@ -31,6 +31,7 @@ struct GraphicsPipelineBuilder {
     bool transparency_enabled = false;
     bool line_topology_enabled = false;
     bool depth_test_enabled = true;
+    bool depth_write_enabled = true;
 
    public:
     GraphicsPipelineBuilder& AddPushConstantRange(VkShaderStageFlags p_shader_stage_flags, uint p_size);
@@ -43,6 +44,8 @@ struct GraphicsPipelineBuilder {
     GraphicsPipelineBuilder& SetTransparency(bool p_enabled);
     GraphicsPipelineBuilder& SetLineTopology(bool p_enabled);
     GraphicsPipelineBuilder& EnableDepthTest(bool p_enabled = true);
+    // Only has an effect with the depth test enabled
+    GraphicsPipelineBuilder& EnableDepthWrite(bool p_enabled = true);
 
     Result<Pipeline> Build(const RendererVulkan& renderer) const;
 
@@ -8,6 +8,8 @@
 #include <gauge/core/app.hpp>
 #include <gauge/core/config.hpp>
 #include <gauge/core/handle.hpp>
+#include <gauge/core/heap_stats.hpp>
+#include <gauge/core/radix_sort.hpp>
 #include <gauge/core/resource_manager.hpp>
 #include <gauge/math/common.hpp>
 #include <gauge/register_types.hpp>
@@ -22,7 +24,10 @@
 #include <gauge/renderer/vulkan/imgui.hpp>
 #include <gauge/renderer/vulkan/shader_module.hpp>
 #include <gauge/scene/node.hpp>
+#include <gauge/scene/scene_bounds.hpp>
 #include <gauge/scene/scene_tree.hpp>
+#include <gauge/scene/transform_hierarchy.hpp>
+#include <gauge/scene/world_streamer.hpp>
 
 #include <SDL3/SDL_error.h>
 #include <SDL3/SDL_mouse.h>
@@ -56,8 +61,10 @@
 #include <expected>
 #include <format>
 #include <memory>
+#include <numeric>
 #include <print>
 #include <string>
+#include <utility>
 #include <vector>
 
 #define TRACY_VK_USE_SYMBOL_TABLE
@@ -84,6 +91,22 @@ VkBool32 validation_layer_callback(
 }
 #endif
 
+static void GlobalBarrier(const CommandBufferVulkan& cmd, VkPipelineStageFlags2 p_src_stage, VkAccessFlags2 p_src_access, VkPipelineStageFlags2 p_dst_stage, VkAccessFlags2 p_dst_access) {
+    const VkMemoryBarrier2 barrier{
+        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+        .srcStageMask = p_src_stage,
+        .srcAccessMask = p_src_access,
+        .dstStageMask = p_dst_stage,
+        .dstAccessMask = p_dst_access,
+    };
+    const VkDependencyInfo dependency_info{
+        .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+        .memoryBarrierCount = 1,
+        .pMemoryBarriers = &barrier,
+    };
+    vkCmdPipelineBarrier2(cmd.GetHandle(), &dependency_info);
+}
+
 VkSampleCountFlagBits RendererVulkan::SampleCountFromMSAA(MSAA p_msaa) {
     switch (p_msaa) {
         case MSAA::OFF:
@@ -144,6 +167,8 @@ CreateInstance(bool p_offscreen = false) {
 static Result<vkb::PhysicalDevice>
 CreatePhysicalDevice(vkb::Instance p_instance, VkSurfaceKHR p_surface) {
     VkPhysicalDeviceFeatures device_features{
+        .multiDrawIndirect = VK_TRUE,
+        .drawIndirectFirstInstance = VK_TRUE,
         .samplerAnisotropy = VK_TRUE,
         .fragmentStoresAndAtomics = VK_TRUE,
         .shaderInt16 = VK_TRUE,
@@ -156,6 +181,7 @@ CreatePhysicalDevice(vkb::Instance p_instance, VkSurfaceKHR p_surface) {
     };
     VkPhysicalDeviceVulkan12Features device_features_12{
         .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+        .drawIndirectCount = VK_TRUE,
         .descriptorIndexing = VK_TRUE,
         .descriptorBindingPartiallyBound = VK_TRUE,
         .runtimeDescriptorArray = VK_TRUE,
@@ -356,20 +382,23 @@ RendererVulkan::CreateFrameData() {
         // Readback buffer
         CHECK_RET(
             CreateBuffer(
-                sizeof(Handle<Node>) * 64,
+                sizeof(GPUReadback) * 64,
                 VK_BUFFER_USAGE_2_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
                 VMA_MEMORY_USAGE_AUTO)
                 .transform([&](GPUBuffer p_buffer) {
                     frame.readback_buffer = p_buffer;
                 }));
-        frame.descriptor_set.WriteStorageBuffer(ctx, 1, 0, frame.readback_buffer.handle, sizeof(Handle<Node>) * 64);
+        frame.descriptor_set.WriteStorageBuffer(ctx, 1, 0, frame.readback_buffer.handle, sizeof(GPUReadback) * 64);
+
+        // GPU driven draw buffers, accessed by address
+        const auto draw_buffers_result = CreateDrawBuffers(frame, INITIAL_DRAW_OBJECTS);
+        CHECK_RET(draw_buffers_result);
 
         // Tracy
 #ifdef TRACY_ENABLE
         frame.tracy_context = TracyVkContext(ctx.physical_device, ctx.device, ctx.graphics_queue, frame.cmd);
         std::string tacy_context_name = std::format("Frame In-Flight Index {}", i);
         TracyVkContextName(frame.tracy_context, tacy_context_name.c_str(), tacy_context_name.size());
-        frames_in_flight.emplace_back(frame);
 #endif
 
         // Debug
@@ -377,6 +406,8 @@ RendererVulkan::CreateFrameData() {
         SetDebugName((uint64_t)frame.cmd, VK_OBJECT_TYPE_COMMAND_BUFFER, std::format("Primary command buffer [{}]", i));
         SetDebugName((uint64_t)frame.queue_submit_fence, VK_OBJECT_TYPE_FENCE, std::format("Queue submit fence [{}]", i));
         SetDebugName((uint64_t)frame.swapchain_acquire_semaphore, VK_OBJECT_TYPE_SEMAPHORE, std::format("Swapchain acquire semaphore [{}]", i));
+
+        frames_in_flight.emplace_back(std::move(frame));
     }
 
     return {};
@@ -596,7 +627,9 @@ Result<> RendererVulkan::InitializeGlobalResources() {
     render_state.camera_views.resize(MAX_CAMERAS);
     render_state.camera_projections.resize(MAX_CAMERAS);
     render_state.camera_view_projections.resize(MAX_CAMERAS);
+    render_state.camera_frustums.resize(MAX_CAMERAS);
 
+    CHECK_RET(CreateCullPipelines());
     Gauge::RegisterShaders();
     Gauge::RegisterMaterialTypes();
 
@@ -777,7 +810,7 @@ RendererVulkan::Initialize(void (*p_create_surface)(VkInstance p_instance, VkSur
     return {};
 }
 
-void RendererVulkan::RenderViewport(const CommandBufferVulkan& cmd, const Viewport& p_viewport, uint p_next_image_index) {
+void RendererVulkan::RenderViewport(const CommandBufferVulkan& cmd, Viewport& p_viewport, uint p_viewport_id, uint p_next_image_index) {
     TracyVkZone(GetCurrentFrame().tracy_context, cmd.GetHandle(), "Viewport");
 
     const bool draw_to_swapchain = p_viewport.settings.use_swapchain && p_viewport.settings.render_scale == 1.0f;
@@ -853,17 +886,25 @@ void RendererVulkan::RenderViewport(const CommandBufferVulkan& cmd, const Viewpo
     vkCmdSetViewport(cmd.GetHandle(), 0, 1, &vk_viewport);
     vkCmdSetScissor(cmd.GetHandle(), 0, 1, &scissor);
 
-    vkCmdBeginRendering(cmd.GetHandle(), &rendering_info);
-
     for (auto& shader : shaders) {
         shader.second->Clear();
     }
+    for (DrawQueue& queue : draw_queues) {
+        queue.objects.clear();
+    }
 
-    p_viewport.scene_tree->root->RefreshTransform();
+    SceneBounds::Get().BeginCulling(render_state.camera_frustums[p_viewport_id], p_viewport.culling_stats);
     p_viewport.scene_tree->Draw();
+    SceneBounds::Get().EndCulling();
 
-    for (auto& shader : shaders) {
-        shader.second->Draw(*this, cmd);
+    // Dispatches have to be recorded before rendering begins
+    CullMeshQueues(cmd, p_viewport_id);
+
+    vkCmdBeginRendering(cmd.GetHandle(), &rendering_info);
+
+    DrawMeshQueues(cmd, p_viewport_id);
+    for (Shader* shader : shader_order) {
+        shader->Draw(*this, cmd);
     }
 
     for (auto callback : render_state.render_callbacks) {
@@ -907,25 +948,33 @@ void RendererVulkan::RenderViewport(const CommandBufferVulkan& cmd, const Viewpo
     }
 }
 
-struct Readback {
-    uint node_handle;
-    float depth;
-};
-
 void RendererVulkan::RecordCommands(const CommandBufferVulkan& cmd, uint p_next_image_index) {
     ZoneScoped;
     TracyVkZone(GetCurrentFrame().tracy_context, cmd.GetHandle(), "Draw");
-    const Readback* readback = (const Readback*)GetCurrentFrame().readback_buffer.allocation.info.pMappedData;
-    uint num_hovered_objects = readback[0].node_handle;
+    FrameArena& arena = GetCurrentFrame().arena;
+    for (auto& shader : shaders) {
+        shader.second->BeginFrame(arena);
+    }
+    for (DrawQueue& queue : draw_queues) {
+        queue.objects = ArenaVector<MeshShader::DrawObject>(arena);
+    }
+    draw_batches = ArenaVector<DrawBatch>(arena);
+    last_draw_stats = std::exchange(draw_stats, DrawStats{});
+    GetCurrentFrame().draw_object_count = 0;
+    GetCurrentFrame().draw_group_count = 0;
+    GetCurrentFrame().draw_batch_count = 0;
+
+    const GPUReadback* readback = (const GPUReadback*)GetCurrentFrame().readback_buffer.allocation.info.pMappedData;
+    uint num_hovered_objects = readback[0].count;
     if (num_hovered_objects > 0) {
-        std::vector<Readback> hovered_objects;
-        std::vector<std::string> names;
+        ArenaVector<GPUReadback> hovered_objects{arena};
+        hovered_objects.reserve(num_hovered_objects);
         for (uint i = 0; i < num_hovered_objects; i++) {
             hovered_objects.emplace_back(readback[i + 1]);
         }
         const struct
         {
-            bool operator()(Readback a, Readback b) const { return a.depth > b.depth; }
+            bool operator()(GPUReadback a, GPUReadback b) const { return a.depth > b.depth; }
         } compare_depth;
         std::sort(hovered_objects.begin(), hovered_objects.end(), compare_depth);
         hovered_node = NodeHandle::FromUint(hovered_objects[0].node_handle);
@@ -959,14 +1008,32 @@ void RendererVulkan::RecordCommands(const CommandBufferVulkan& cmd, uint p_next_
 
         render_state.camera_projections[i] = projection;
         render_state.camera_view_projections[i] = projection * render_state.camera_views[i];
+        render_state.camera_frustums[i] = Frustum::FromMatrix(render_state.camera_view_projections[i]);
 
         global_uniforms.cameras[i] = GPUCamera{
             .view = render_state.camera_views[i],
             .view_projection = render_state.camera_view_projections[i],
             .inverse_projection = glm::inverse(projection),
             .pixel_size = 1.0f / Vec2(viewport.settings.width, viewport.settings.height)};
+        std::ranges::copy(render_state.camera_frustums[i].planes, global_uniforms.cameras[i].frustum_planes);
     }
-    global_uniforms.scenes[0] = render_state.scenes[0];
+    GPUScene& scene = render_state.scenes[0];
+    // Lights are appended from update jobs in whatever order they finish,
+    // sorting keeps the light order stable between frames and runs. Lights
+    // on the same node are ordered by their contents.
+    const auto point_lights = render_state.point_lights.Items();
+    std::ranges::sort(point_lights, [](const QueuedPointLight& a, const QueuedPointLight& b) {
+        if (a.node_handle != b.node_handle) {
+            return a.node_handle < b.node_handle;
+        }
+        return std::memcmp(&a.light, &b.light, sizeof(GPUPointLight)) < 0;
+    });
+    for (uint i = 0; i < point_lights.size(); ++i) {
+        scene.point_lights[i] = point_lights[i].light;
+    }
+    scene.active_point_lights = point_lights.size();
+    render_state.point_lights.Clear();
+    global_uniforms.scenes[0] = scene;
 
     memcpy(GetCurrentFrame().uniform_buffer.allocation.info.pMappedData, &global_uniforms, sizeof(GPUGlobals));
 
@@ -992,9 +1059,13 @@ void RendererVulkan::RecordCommands(const CommandBufferVulkan& cmd, uint p_next_
         vkCmdPipelineBarrier2(cmd.GetHandle(), &dependency_info);
     }
 
+    // Once per frame rather than per viewport
+    TransformHierarchy::Get().Update();
+    SceneBounds::Get().Update();
+
     // Render
-    for (const auto& viewport : render_state.viewports) {
-        RenderViewport(cmd, viewport, p_next_image_index);
+    for (uint i = 0; i < render_state.viewports.size(); ++i) {
+        RenderViewport(cmd, render_state.viewports[i], i, p_next_image_index);
     }
 
     // RenderImGui(cmd, p_next_image_index);
@@ -1011,12 +1082,17 @@ static void NodeTree(const Ref<Node>& node) {
     ImGui::Checkbox(std::format("##{}_vis", node->name).c_str(), &node->visible);
     ImGui::PopStyleVar();
     if (open) {
+        Transform transform = node->GetTransform();
+        bool changed = false;
         ImGui::Text("Position");
-        ImGui::InputFloat("x", &node->local_transform.position.x, 0.01f, 0.1f, "%.3f");
-        ImGui::InputFloat("y", &node->local_transform.position.y, 0.01f, 0.1f, "%.3f");
-        ImGui::InputFloat("z", &node->local_transform.position.z, 0.01f, 0.1f, "%.3f");
+        changed |= ImGui::InputFloat("x", &transform.position.x, 0.01f, 0.1f, "%.3f");
+        changed |= ImGui::InputFloat("y", &transform.position.y, 0.01f, 0.1f, "%.3f");
+        changed |= ImGui::InputFloat("z", &transform.position.z, 0.01f, 0.1f, "%.3f");
 
-        ImGui::InputFloat("Scale", &node->local_transform.scale, 0.01f, 0.1f, "%.3f");
+        changed |= ImGui::InputFloat("Scale", &transform.scale, 0.01f, 0.1f, "%.3f");
+        if (changed) {
+            node->SetTransform(transform);
+        }
 
         for (auto const& component : node->GetComponents()) {
             bool is_component_open = ImGui::TreeNode("MeshInstance");
@@ -1061,13 +1137,21 @@ void RendererVulkan::Draw() {
         ImGui::Render();
     }
 
-    const FrameData& current_frame = GetCurrentFrame();
+    FrameData& current_frame = GetCurrentFrame();
     uint next_image_index = 0;
     {
         ZoneScopedN("vkWaitForFences");
         while (vkWaitForFences(ctx.device, 1, &current_frame.queue_submit_fence, VK_TRUE, UINT64_MAX) == VK_TIMEOUT)
             ;
     }
+    current_frame.arena.Reset();
+    ReleaseRetiredResources();
+    TracyPlot("Frame arena heap allocations", (int64_t)current_frame.arena.GetStats().heap_allocations);
+    // Everything since the last frame started, including the update phase.
+    // Nonzero in steady state means something still allocates per frame.
+    const uint64_t allocations = HeapStats::GetAllocationCount();
+    TracyPlot("Heap allocations per frame", (int64_t)(allocations - frame_start_allocations));
+    frame_start_allocations = allocations;
     {
         ZoneScopedN("vkAcquireNextImage");
         // TODO: Check result value and recreate swapchain if necessary
@@ -1080,9 +1164,13 @@ void RendererVulkan::Draw() {
              "Could not reset command pool");
 
     const VkCommandBuffer current_command_buffer = current_frame.cmd;
-    CommandBufferVulkan cmd{current_command_buffer};
+    CommandBufferVulkan cmd{current_command_buffer, &draw_stats};
 
     CHECK(cmd.Begin());
+    BeginUploads(cmd);
+    ResourceManager::ProcessUploads();
+    WorldStreamer::Get().Update(render_state.viewports[0].camera_position);
+    EndUploads(cmd);
     RecordCommands(cmd, next_image_index);
     TracyVkCollect(current_frame.tracy_context, cmd.GetHandle());
     CHECK(cmd.End());
@@ -1130,11 +1218,28 @@ void RendererVulkan::Draw() {
 }
 
 void RendererVulkan::DrawOffscreen() {
-    FrameData current_frame = GetCurrentFrame();
+    FrameData& current_frame = GetCurrentFrame();
+    // Fenced like Draw, retired geometry and the frame's buffers may still
+    // be in use by the last submission of this frame
+    {
+        ZoneScopedN("vkWaitForFences");
+        while (vkWaitForFences(ctx.device, 1, &current_frame.queue_submit_fence, VK_TRUE, UINT64_MAX) == VK_TIMEOUT)
+            ;
+    }
+    current_frame.arena.Reset();
+    ReleaseRetiredResources();
+    VK_CHECK(vkResetFences(ctx.device, 1, &current_frame.queue_submit_fence),
+             "Could not reset queue submit fence");
+    VK_CHECK(vkResetCommandPool(ctx.device, current_frame.cmd_pool, 0),
+             "Could not reset command pool");
     VkCommandBuffer current_command_buffer = current_frame.cmd;
-    CommandBufferVulkan cmd{current_command_buffer};
+    CommandBufferVulkan cmd{current_command_buffer, &draw_stats};
 
     CHECK(cmd.Begin());
+    BeginUploads(cmd);
+    ResourceManager::ProcessUploads();
+    WorldStreamer::Get().Update(render_state.viewports[0].camera_position);
+    EndUploads(cmd);
     RecordCommands(cmd, 0);
     TracyVkCollect(current_frame.tracy_context, cmd.GetHandle());
     CHECK(cmd.End());
@@ -1148,7 +1253,7 @@ void RendererVulkan::DrawOffscreen() {
             .commandBufferCount = 1,
             .pCommandBuffers = &current_command_buffer,
         };
-        VK_CHECK(vkQueueSubmit(ctx.graphics_queue, 1, &submit_info, VK_NULL_HANDLE),
+        VK_CHECK(vkQueueSubmit(ctx.graphics_queue, 1, &submit_info, current_frame.queue_submit_fence),
                  "Could not submit command buffer to graphics queue");
     }
     FrameMark;
@@ -1228,7 +1333,7 @@ RendererVulkan::CreateBuffer(size_t p_allocation_size, VkBufferUsageFlags p_usag
 }
 
 Result<GPUMesh>
-RendererVulkan::UploadMeshToGPU(const glTF::Primitive& primitive) const {
+RendererVulkan::UploadMeshToGPU(const glTF::Primitive& primitive) {
     return UploadMeshToGPU(primitive.vertices, primitive.indices);
 }
 
@@ -1304,16 +1409,19 @@ RendererVulkan::CreateImage(
 
 Result<GPUImage>
 RendererVulkan::UploadTextureToGPU(const Texture& p_texture) {
-    vkDeviceWaitIdle(ctx.device);
     GPUImage image{};
 
     if (p_texture.ktx_texture != nullptr) {
+        // libktx submits its own commands and waits for them, so KTX
+        // textures are not recorded into the frame
+        vkDeviceWaitIdle(ctx.device);
         ktxVulkanTexture ktx_vk_texture{};
         auto result = ktxTexture2_VkUploadEx(p_texture.ktx_texture, &ktx_context, &ktx_vk_texture, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_SAMPLED_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
         if (result != KTX_SUCCESS) {
             return Error(std::format("Could not upload Vulkan KTX texture to GPU. Error: {}", ktxErrorString(result)));
         }
         image.handle = ktx_vk_texture.image;
+        image.memory = ktx_vk_texture.deviceMemory;
         image.format = ktx_vk_texture.imageFormat;
 
         const VkImageViewCreateInfo view_info{
@@ -1351,7 +1459,7 @@ RendererVulkan::UploadTextureToGPU(const Texture& p_texture) {
             .and_then([&](GPUBuffer p_staging_buffer) {
                 staging_buffer = p_staging_buffer;
                 memcpy(staging_buffer.allocation.info.pMappedData, p_texture.data, p_texture.GetSize());
-                return ImmediateSubmit([&](CommandBufferVulkan cmd) {
+                return SubmitUpload([&](CommandBufferVulkan cmd) {
                     cmd.TransitionImage(
                         image.handle,
                         VK_IMAGE_LAYOUT_UNDEFINED,
@@ -1375,7 +1483,7 @@ RendererVulkan::UploadTextureToGPU(const Texture& p_texture) {
                 });
             })
             .and_then([&]() -> Result<GPUImage> {
-                vmaDestroyBuffer(ctx.allocator, staging_buffer.handle, staging_buffer.allocation.handle);
+                ReleaseStagingBuffer(staging_buffer);
                 return image;
             });
     }
@@ -1413,6 +1521,34 @@ RendererVulkan::ImmediateSubmit(std::function<void(CommandBufferVulkan p_cmd)>&&
     return {};
 }
 
+Result<> RendererVulkan::SubmitUpload(std::function<void(CommandBufferVulkan p_cmd)>&& p_function) {
+    if (upload_cmd == VK_NULL_HANDLE) {
+        return ImmediateSubmit(std::move(p_function));
+    }
+    p_function(upload_cmd);
+    return {};
+}
+
+void RendererVulkan::ReleaseStagingBuffer(const GPUBuffer& p_buffer) {
+    if (upload_cmd == VK_NULL_HANDLE) {
+        vmaDestroyBuffer(ctx.allocator, p_buffer.handle, p_buffer.allocation.handle);
+        return;
+    }
+    // Read when the frame executes
+    retired_buffers.push_back(RetiredBuffer{p_buffer, max_frames_in_flight + 1});
+}
+
+void RendererVulkan::BeginUploads(const CommandBufferVulkan& cmd) {
+    upload_cmd = cmd.GetHandle();
+}
+
+void RendererVulkan::EndUploads(const CommandBufferVulkan& cmd) {
+    upload_cmd = VK_NULL_HANDLE;
+    GlobalBarrier(cmd,
+                  VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                  VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_READ_BIT);
+}
+
 Result<GPUImage>
 RendererVulkan::CreateDepthImage(const uint p_width, const uint p_height, VkSampleCountFlagBits p_sample_count) const {
     return CreateImage(
@@ -1437,6 +1573,10 @@ RendererVulkan::CreateDepthImage(const uint p_width, const uint p_height, VkSamp
 void RendererVulkan::DestroyImage(GPUImage& p_image) const {
     vkDestroyImageView(ctx.device, p_image.view, nullptr);
     vmaDestroyImage(ctx.allocator, p_image.handle, p_image.allocation.handle);
+    if (p_image.memory != VK_NULL_HANDLE) {
+        vkFreeMemory(ctx.device, p_image.memory, nullptr);
+        p_image.memory = VK_NULL_HANDLE;
+    }
     p_image.handle = VK_NULL_HANDLE;
     p_image.view = VK_NULL_HANDLE;
     p_image.format = VK_FORMAT_UNDEFINED;
@@ -1542,7 +1682,161 @@ RendererVulkan::CreateMesh(std::vector<PositionVertex> p_vertices, std::vector<u
 }
 
 void RendererVulkan::DestroyMesh(Handle<GPUMesh> p_handle) {
-    // TODO
+    const GPUMesh* mesh = resources.meshes.Get(p_handle);
+    if (mesh == nullptr) {
+        return;
+    }
+    // Frames in flight may still draw from its ranges
+    retired_meshes.push_back(RetiredMesh{*mesh, max_frames_in_flight + 1});
+    resources.meshes.Free(p_handle);
+}
+
+Result<VkDeviceSize>
+RendererVulkan::AllocateGeometry(GeometryBuffer& r_geometry, VkDeviceSize p_size, VkDeviceSize p_alignment) {
+    if (p_size == 0) {
+        return 0;
+    }
+    VkDeviceSize offset = r_geometry.allocator.Allocate(p_size, p_alignment);
+    if (offset == RangeAllocator::INVALID_OFFSET) {
+        const VkDeviceSize capacity = r_geometry.allocator.GetCapacity();
+        const auto grow_result = GrowGeometry(r_geometry, std::max({capacity * 2, capacity + p_size + p_alignment, r_geometry.initial_capacity}));
+        CHECK_RET(grow_result);
+        offset = r_geometry.allocator.Allocate(p_size, p_alignment);
+    }
+    return offset;
+}
+
+Result<> RendererVulkan::GrowGeometry(GeometryBuffer& r_geometry, VkDeviceSize p_capacity) {
+    const auto buffer_result = CreateBuffer(p_capacity, r_geometry.usage, VMA_MEMORY_USAGE_GPU_ONLY);
+    CHECK_RET(buffer_result);
+    GPUBuffer buffer = buffer_result.value();
+    if (r_geometry.usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) {
+        const VkBufferDeviceAddressInfo address_info{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+            .buffer = buffer.handle,
+        };
+        buffer.address = vkGetBufferDeviceAddress(ctx.device, &address_info);
+    }
+
+    // Recorded into the frame like the uploads, so growing doesn't wait for
+    // the GPU. Frames in flight keep reading the old buffer until it is released.
+    const VkDeviceSize old_capacity = r_geometry.allocator.GetCapacity();
+    if (old_capacity > 0) {
+        const auto copy_result = SubmitUpload([&](CommandBufferVulkan cmd) {
+            // Uploads recorded earlier land in the old buffer before it is
+            // copied, later ones in the new buffer after it
+            GlobalBarrier(cmd,
+                          VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                          VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT);
+            const VkBufferCopy copy{
+                .size = old_capacity,
+            };
+            vkCmdCopyBuffer(cmd.GetHandle(), r_geometry.buffer.handle, buffer.handle, 1, &copy);
+            GlobalBarrier(cmd,
+                          VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                          VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+        });
+        if (!copy_result) {
+            vmaDestroyBuffer(ctx.allocator, buffer.handle, buffer.allocation.handle);
+        }
+        CHECK_RET(copy_result);
+        retired_buffers.push_back(RetiredBuffer{r_geometry.buffer, max_frames_in_flight + 1});
+    }
+    r_geometry.buffer = buffer;
+    r_geometry.allocator.Grow(p_capacity);
+    return {};
+}
+
+Result<> RendererVulkan::CreateDrawBuffers(FrameData& r_frame, uint p_capacity) {
+    struct DrawBuffer {
+        GPUBuffer* buffer;
+        size_t element_size;
+        VkBufferUsageFlags usage;
+        VmaMemoryUsage memory_usage;
+    };
+    const DrawBuffer draw_buffers[] = {
+        {&r_frame.draw_object_buffer, sizeof(GPUDrawObject), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU},
+        {&r_frame.draw_group_buffer, sizeof(GPUDrawGroup), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU},
+        {&r_frame.draw_instance_buffer, sizeof(uint), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VMA_MEMORY_USAGE_GPU_ONLY},
+        {&r_frame.draw_instance_count_buffer, sizeof(uint), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_ONLY},
+        {&r_frame.draw_command_buffer, sizeof(VkDrawIndexedIndirectCommand), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, VMA_MEMORY_USAGE_GPU_ONLY},
+        {&r_frame.draw_count_buffer, sizeof(uint), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_ONLY},
+    };
+
+    GPUBuffer buffers[std::size(draw_buffers)];
+    for (uint i = 0; i < std::size(draw_buffers); ++i) {
+        const DrawBuffer& draw_buffer = draw_buffers[i];
+        const auto buffer_result = CreateBuffer(draw_buffer.element_size * p_capacity, draw_buffer.usage | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT, draw_buffer.memory_usage);
+        if (!buffer_result) {
+            for (uint j = 0; j < i; ++j) {
+                vmaDestroyBuffer(ctx.allocator, buffers[j].handle, buffers[j].allocation.handle);
+            }
+        }
+        CHECK_RET(buffer_result);
+        buffers[i] = buffer_result.value();
+        const VkBufferDeviceAddressInfo address_info{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+            .buffer = buffers[i].handle,
+        };
+        buffers[i].address = vkGetBufferDeviceAddress(ctx.device, &address_info);
+    }
+
+    // Commands recorded for earlier viewports of the frame still use the old
+    // buffers, the objects they wrote stay where they are
+    for (uint i = 0; i < std::size(draw_buffers); ++i) {
+        if (r_frame.draw_capacity > 0) {
+            retired_buffers.push_back(RetiredBuffer{*draw_buffers[i].buffer, max_frames_in_flight + 1});
+        }
+        *draw_buffers[i].buffer = buffers[i];
+    }
+    r_frame.draw_capacity = p_capacity;
+    return {};
+}
+
+void RendererVulkan::ReleaseRetiredResources() {
+    std::erase_if(retired_buffers, [&](RetiredBuffer& r_retired) {
+        if (--r_retired.frames_left > 0) {
+            return false;
+        }
+        vmaDestroyBuffer(ctx.allocator, r_retired.buffer.handle, r_retired.buffer.allocation.handle);
+        return true;
+    });
+    std::erase_if(retired_meshes, [&](RetiredMesh& r_retired) {
+        if (--r_retired.frames_left > 0) {
+            return false;
+        }
+        resources.vertices.allocator.Free(r_retired.mesh.vertex_offset, r_retired.mesh.vertex_size);
+        resources.indices.allocator.Free(r_retired.mesh.first_index * sizeof(uint), r_retired.mesh.index_count * sizeof(uint));
+        return true;
+    });
+    std::erase_if(retired_textures, [&](RetiredTexture& r_retired) {
+        if (--r_retired.frames_left > 0) {
+            return false;
+        }
+        // Destroying a texture twice retires it twice
+        if (GPUImage* image = resources.textures.Get(r_retired.handle); image != nullptr) {
+            DestroyImage(*image);
+            resources.textures.Free(r_retired.handle);
+        }
+        return true;
+    });
+    std::erase_if(retired_materials, [&](RetiredMaterial& r_retired) {
+        if (--r_retired.frames_left > 0) {
+            return false;
+        }
+        const GPUMaterial* material = resources.materials.Get(r_retired.handle);
+        if (material == nullptr) {
+            return true;
+        }
+        for (const auto& [type, material_type_data] : material_types) {
+            if (material_type_data.id == material->type) {
+                material_type_data.free(material->id);
+                break;
+            }
+        }
+        resources.materials.Free(r_retired.handle);
+        return true;
+    });
 }
 
 Handle<GPUImage>
@@ -1563,11 +1857,18 @@ RendererVulkan::CreateTexture(const Texture& p_texture) {
 }
 
 void RendererVulkan::DestroyTexture(Handle<GPUImage> p_handle) {
-    // TODO
+    if (resources.textures.Get(p_handle) == nullptr) {
+        return;
+    }
+    // Frames in flight may still sample it
+    retired_textures.push_back(RetiredTexture{p_handle, max_frames_in_flight + 1});
 }
 
-void RendererVulkan::DestroyMaterial(Handle<GPU_PBRMaterial> p_handle) {
-    // TODO
+void RendererVulkan::DestroyMaterial(Handle<GPUMaterial> p_handle) {
+    if (resources.materials.Get(p_handle) == nullptr) {
+        return;
+    }
+    retired_materials.push_back(RetiredMaterial{p_handle, max_frames_in_flight + 1});
 }
 
 void RendererVulkan::OnShaderChanged() {
@@ -1602,6 +1903,266 @@ RendererVulkan::ViewportGetCameraRotation(uint p_viewport_id) {
            glm::angleAxis(viewport.camera_pitch, Vec3::RIGHT);
 }
 
+uint RendererVulkan::GetDrawQueue(StringID p_shader_id, bool p_transparent) const {
+    for (uint i = 0; i < draw_queues.size(); ++i) {
+        const DrawQueue& queue = draw_queues[i];
+        if (queue.shader->id == p_shader_id && queue.pass == queue.shader->GetPass(p_transparent)) {
+            return i;
+        }
+    }
+    return INVALID_DRAW_QUEUE;
+}
+
+void RendererVulkan::WriteDrawObjects(uint p_camera_id) {
+    FrameData& frame = GetCurrentFrame();
+    draw_batches.clear();
+
+    // Matrices are computed per queue, where the transforms are contiguous,
+    // and indexed like the keys before sorting
+    struct DrawItem {
+        uint queue;
+        uint object;
+    };
+    ArenaVector<DrawItem> items(frame.arena);
+    ArenaVector<uint64_t> keys(frame.arena);
+    ArenaVector<Mat4> matrices(frame.arena);
+    const glm::vec3 eye = glm::inverse(render_state.camera_views[p_camera_id])[3];
+    for (uint queue_index = 0; queue_index < draw_queues.size(); ++queue_index) {
+        const DrawQueue& queue = draw_queues[queue_index];
+        for (uint i = 0; i < queue.objects.size(); ++i) {
+            const MeshShader::DrawObject& object = queue.objects[i];
+            const float depth = glm::distance(glm::vec3(object.transform.position), eye);
+            keys.push_back(queue.pass == MeshShader::Pass::OPAQUE
+                               ? DrawKey::Opaque(uint(queue.pass), queue_index, object.material.index, object.primitive.index, depth)
+                               : DrawKey::Blended(uint(queue.pass), queue_index, object.material.index, object.primitive.index, depth));
+            items.push_back(DrawItem{queue_index, i});
+        }
+        if (!queue.objects.empty()) {
+            const size_t first = matrices.size();
+            matrices.resize(first + queue.objects.size());
+            Math::TransformsToMatrices(&queue.objects[0].transform, queue.objects.size(), &matrices[first], sizeof(MeshShader::DrawObject));
+        }
+    }
+
+    const uint first_object = frame.draw_object_count;
+    if (first_object + keys.size() > frame.draw_capacity) {
+        const auto grow_result = CreateDrawBuffers(frame, std::max<uint>(frame.draw_capacity * 2, first_object + keys.size()));
+        if (!grow_result && !draw_overflow_reported) {
+            std::println("Gauge Error: Could not grow the draw buffers, objects are dropped: {}", grow_result.error());
+            draw_overflow_reported = true;
+        }
+    }
+    // Only if growing failed, the objects at the end of the draw order are lost
+    const uint count = std::min<uint>(keys.size(), frame.draw_capacity - first_object);
+    draw_stats.dropped_objects += keys.size() - count;
+    if (count == 0) {
+        return;
+    }
+    ArenaVector<uint> order(keys.size(), frame.arena);
+    std::iota(order.begin(), order.end(), 0);
+    ArenaVector<uint64_t> scratch_keys(keys.size(), frame.arena);
+    ArenaVector<uint> scratch_order(keys.size(), frame.arena);
+    RadixSort<uint>(keys, order, scratch_keys, scratch_order);
+
+    GPUDrawObject* draw_objects = static_cast<GPUDrawObject*>(frame.draw_object_buffer.allocation.info.pMappedData) + first_object;
+    GPUDrawGroup* draw_groups = static_cast<GPUDrawGroup*>(frame.draw_group_buffer.allocation.info.pMappedData);
+    const MeshShader::DrawObject* previous = nullptr;
+    const GPUMesh* mesh = nullptr;
+    GPUMaterial material{};
+    for (uint i = 0; i < count; ++i) {
+        const DrawItem& item = items[order[i]];
+        const DrawQueue& queue = draw_queues[item.queue];
+        const MeshShader::DrawObject& object = queue.objects[item.object];
+        // All meshes share one index buffer, so a batch spans a whole queue
+        const bool new_batch = draw_batches.empty() || draw_batches.back().queue != item.queue;
+        if (new_batch) {
+            draw_batches.push_back(DrawBatch{
+                .queue = item.queue,
+                .first_command = frame.draw_group_count,
+                .max_count = 0,
+                .count_index = frame.draw_batch_count++,
+            });
+        }
+        DrawBatch& batch = draw_batches.back();
+
+        // Blended objects get a group and command of their own, which keeps
+        // them in order. Opaque ones are instanced.
+        const bool ordered = queue.pass != MeshShader::Pass::OPAQUE;
+        if (new_batch || ordered || previous->primitive != object.primitive || previous->material != object.material) {
+            if (new_batch || previous->primitive != object.primitive) {
+                mesh = resources.meshes.Get(object.primitive);
+            }
+            material = *resources.materials.Get(object.material);
+            draw_groups[frame.draw_group_count++] = GPUDrawGroup{
+                .index_count = mesh->index_count,
+                .first_index = mesh->first_index,
+                .first_instance = first_object + i,
+                .batch = batch.count_index,
+                .first_command = batch.first_command,
+                .command = ordered ? batch.max_count : GPUDrawGroup::APPEND_COMMAND,
+            };
+            batch.max_count++;
+        }
+        previous = &object;
+
+        // Invalid bounds are never culled
+        const AABB bounds = queue.shader->cull ? mesh->bounds : AABB();
+        GPUDrawObject& draw_object = draw_objects[i];
+        draw_object.model_matrix = matrices[order[i]];
+        draw_object.bounds_min = bounds.min;
+        draw_object.group = frame.draw_group_count - 1;
+        draw_object.bounds_max = bounds.max;
+        draw_object.node_handle = object.node_handle;
+        draw_object.vertex_buffer_address = GetVertexAddress(*mesh);
+        draw_object.material = material;
+    }
+    frame.draw_object_count += count;
+}
+
+void RendererVulkan::DrawMeshQueues(const CommandBufferVulkan& cmd, uint p_camera_id) {
+    const FrameData& frame = GetCurrentFrame();
+    if (draw_batches.empty()) {
+        return;
+    }
+    cmd.BindIndexBuffer(resources.indices.buffer.handle);
+
+    for (const DrawBatch& batch : draw_batches) {
+        const DrawQueue& queue = draw_queues[batch.queue];
+        queue.shader->Bind(*this, cmd, queue.pass, p_camera_id);
+        cmd.DrawIndexedIndirectCount(
+            frame.draw_command_buffer.handle,
+            batch.first_command * sizeof(VkDrawIndexedIndirectCommand),
+            frame.draw_count_buffer.handle,
+            batch.count_index * sizeof(uint),
+            batch.max_count);
+    }
+}
+
+struct CullPushConstants {
+    VkDeviceAddress draw_objects;
+    VkDeviceAddress draw_groups;
+    VkDeviceAddress draw_instances;
+    VkDeviceAddress draw_instance_counts;
+    VkDeviceAddress draw_commands;
+    VkDeviceAddress draw_counts;
+    uint first_object;
+    uint object_count;
+    uint first_group;
+    uint group_count;
+    uint camera_id;
+};
+
+Result<> RendererVulkan::CreateCullPipelines() {
+    auto shader_module_result = ShaderModule::FromFile(ctx, "shaders/mesh_cull.spv");
+    CHECK_RET(shader_module_result);
+    const ShaderModule shader_module = shader_module_result.value();
+
+    const VkDescriptorSetLayout set_layouts[] = {
+        global_descriptor.layout,
+        frames_in_flight[0].descriptor_set.GetLayout(),
+    };
+    const VkPushConstantRange push_constant_range{
+        .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+        .size = sizeof(CullPushConstants),
+    };
+    const VkPipelineLayoutCreateInfo pipeline_layout_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+        .setLayoutCount = 2,
+        .pSetLayouts = set_layouts,
+        .pushConstantRangeCount = 1,
+        .pPushConstantRanges = &push_constant_range,
+    };
+    VkPipelineLayout layout{};
+    VK_CHECK_RET(vkCreatePipelineLayout(ctx.device, &pipeline_layout_info, nullptr, &layout),
+                 "Could not create culling pipeline layout");
+    SetDebugName((uint64_t)layout, VK_OBJECT_TYPE_PIPELINE_LAYOUT, "Mesh culling layout");
+
+    // Both passes share the layout, so bound sets and push constants carry over
+    const std::pair<Pipeline*, const char*> pipelines[] = {
+        {&cull_pipeline, "CullMain"},
+        {&draw_command_pipeline, "WriteDrawCommands"},
+    };
+    for (auto [pipeline, entry_point] : pipelines) {
+        const VkComputePipelineCreateInfo pipeline_info{
+            .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+            .stage = {
+                .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+                .stage = VK_SHADER_STAGE_COMPUTE_BIT,
+                .module = shader_module.handle,
+                .pName = entry_point,
+            },
+            .layout = layout,
+        };
+        pipeline->layout = layout;
+        pipeline->bind_point = VK_PIPELINE_BIND_POINT_COMPUTE;
+        VK_CHECK_RET(vkCreateComputePipelines(ctx.device, VK_NULL_HANDLE, 1, &pipeline_info, nullptr, &pipeline->handle),
+                     "Could not create culling pipeline");
+        SetDebugName((uint64_t)pipeline->handle, VK_OBJECT_TYPE_PIPELINE, entry_point);
+    }
+    vkDestroyShaderModule(ctx.device, shader_module.handle, nullptr);
+    return {};
+}
+
+void RendererVulkan::CullMeshQueues(const CommandBufferVulkan& cmd, uint p_camera_id) {
+    ZoneScoped;
+    FrameData& frame = GetCurrentFrame();
+    const uint first_object = frame.draw_object_count;
+    const uint first_group = frame.draw_group_count;
+    const uint first_batch = frame.draw_batch_count;
+    WriteDrawObjects(p_camera_id);
+    const uint object_count = frame.draw_object_count - first_object;
+    const uint group_count = frame.draw_group_count - first_group;
+    const uint batch_count = frame.draw_batch_count - first_batch;
+    if (object_count == 0) {
+        return;
+    }
+
+    // Earlier viewports of the frame use the ranges before these
+    vkCmdFillBuffer(cmd.GetHandle(), frame.draw_instance_count_buffer.handle, first_group * sizeof(uint), group_count * sizeof(uint), 0);
+    vkCmdFillBuffer(cmd.GetHandle(), frame.draw_count_buffer.handle, first_batch * sizeof(uint), batch_count * sizeof(uint), 0);
+    GlobalBarrier(cmd,
+                   VK_PIPELINE_STAGE_2_CLEAR_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                   VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+
+    const VkDescriptorSet sets[] = {
+        global_descriptor.set.handle,
+        frame.descriptor_set.handle,
+    };
+    vkCmdBindDescriptorSets(cmd.GetHandle(), VK_PIPELINE_BIND_POINT_COMPUTE, cull_pipeline.layout, 0, 2, sets, 0, nullptr);
+    const CullPushConstants pcs{
+        .draw_objects = frame.draw_object_buffer.address,
+        .draw_groups = frame.draw_group_buffer.address,
+        .draw_instances = frame.draw_instance_buffer.address,
+        .draw_instance_counts = frame.draw_instance_count_buffer.address,
+        .draw_commands = frame.draw_command_buffer.address,
+        .draw_counts = frame.draw_count_buffer.address,
+        .first_object = first_object,
+        .object_count = object_count,
+        .first_group = first_group,
+        .group_count = group_count,
+        .camera_id = p_camera_id,
+    };
+    vkCmdPushConstants(cmd.GetHandle(), cull_pipeline.layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstants), &pcs);
+
+    cmd.BindPipeline(cull_pipeline);
+    vkCmdDispatch(cmd.GetHandle(), (object_count + 63) / 64, 1, 1);
+    GlobalBarrier(cmd,
+                   VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                   VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+
+    cmd.BindPipeline(draw_command_pipeline);
+    vkCmdDispatch(cmd.GetHandle(), (group_count + 63) / 64, 1, 1);
+    GlobalBarrier(cmd,
+                   VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                   VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                   VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_READ_BIT);
+}
+
+const SceneBounds::CullingStats&
+RendererVulkan::ViewportGetCullingStats(uint p_viewport_id) const {
+    return render_state.viewports[p_viewport_id].culling_stats;
+}
+
 NodeHandle
 RendererVulkan::GetHoveredNode() {
     return hovered_node;
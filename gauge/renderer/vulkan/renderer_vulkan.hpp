@@ -1,21 +1,31 @@
 #pragma once
 
 #include <gauge/common.hpp>
+#include <gauge/core/append_buffer.hpp>
+#include <gauge/core/frame_arena.hpp>
 #include <gauge/core/handle.hpp>
 #include <gauge/core/pool.hpp>
+#include <gauge/core/range_allocator.hpp>
+#include <gauge/math/batch.hpp>
 #include <gauge/math/common.hpp>
 #include <gauge/renderer/common.hpp>
+#include <gauge/renderer/draw_key.hpp>
+#include <gauge/renderer/frustum.hpp>
 #include <gauge/renderer/gltf.hpp>
 #include <gauge/renderer/renderer.hpp>
+#include <gauge/renderer/shaders/mesh_shader.hpp>
 #include <gauge/renderer/shaders/shader.hpp>
 #include <gauge/renderer/texture.hpp>
 #include <gauge/renderer/vulkan/command_buffer.hpp>
 #include <gauge/renderer/vulkan/common.hpp>
 #include <gauge/renderer/vulkan/descriptor.hpp>
+#include <gauge/scene/scene_bounds.hpp>
 #include <gauge/scene/scene_tree.hpp>
 
 #include <SDL3/SDL_video.h>
 #include <sys/types.h>
+#include <algorithm>
+#include <cassert>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -51,6 +61,24 @@ struct RendererVulkan : public Renderer {
         GPUBuffer uniform_buffer{};
         GPUBuffer readback_buffer{};
 
+        // GPU driven drawing: objects and groups written by the mesh shaders,
+        // and the instances, indirect commands and per batch draw counts
+        // culling them produces
+        GPUBuffer draw_object_buffer{};
+        GPUBuffer draw_group_buffer{};
+        GPUBuffer draw_instance_buffer{};
+        GPUBuffer draw_instance_count_buffer{};
+        GPUBuffer draw_command_buffer{};
+        GPUBuffer draw_count_buffer{};
+        uint draw_object_count = 0;
+        uint draw_group_count = 0;
+        uint draw_batch_count = 0;
+        // Objects the draw buffers hold, see CreateDrawBuffers
+        uint draw_capacity = 0;
+
+        // Transient CPU data of the frame, reset once its fence has signaled
+        FrameArena arena{};
+
 #ifdef TRACY_ENABLE
         tracy::VkCtx* tracy_context{};
 #endif
@@ -80,6 +108,9 @@ struct RendererVulkan : public Renderer {
         GPUImage depth_multisampled{};
 
         std::shared_ptr<SceneTree> scene_tree{};
+
+        // Of the last frame
+        SceneBounds::CullingStats culling_stats{};
     };
 
     std::vector<VkSemaphore>
@@ -90,8 +121,40 @@ struct RendererVulkan : public Renderer {
     uint64_t current_frame_index = 0;
 
     Pipeline aabb_pipeline{};
+    Pipeline cull_pipeline{};
+    Pipeline draw_command_pipeline{};
 
     std::unordered_map<std::type_index, Ref<Shader>> shaders;
+    // In the order they were registered, which is the order they are drawn in
+    std::vector<Shader*> shader_order;
+
+    // Objects submitted to a pass of a mesh shader, by draw queue index
+    struct DrawQueue {
+        MeshShader* shader;
+        MeshShader::Pass pass;
+        ArenaVector<MeshShader::DrawObject> objects;
+    };
+    std::vector<DrawQueue> draw_queues;
+
+    // Consecutive draw groups of a queue, in draw key order. Each is drawn
+    // with one indirect draw.
+    struct DrawBatch {
+        uint queue;
+        uint first_command;
+        // Number of groups
+        uint max_count;
+        // Index into the frame's draw counts
+        uint count_index;
+    };
+    ArenaVector<DrawBatch> draw_batches;
+
+    // Of the frame being recorded and of the last one. The frame's command
+    // buffer counts every draw recorded through it, ImGui's excluded.
+    DrawStats draw_stats{};
+    DrawStats last_draw_stats{};
+    bool draw_overflow_reported = false;
+    // HeapStats::GetAllocationCount when the current frame started
+    uint64_t frame_start_allocations = 0;
 
     // Updated when loading assets: Textures, samplers, materials...
     struct GlobalDescriptor {
@@ -107,14 +170,24 @@ struct RendererVulkan : public Renderer {
         uint height{};
     } window_size;
 
+    struct QueuedPointLight {
+        // Sort key, see Node::handle
+        uint64_t node_handle;
+        GPUPointLight light;
+    };
+
     struct RenderState {
         std::vector<Viewport> viewports;
         std::vector<GPUScene> scenes;
+        // Appended to by components during the update phase, sorted and
+        // moved into scenes[0] when the frame is recorded
+        AppendBuffer<QueuedPointLight, MAX_POINT_LIGHTS> point_lights;
         std::vector<Model> models;
         std::vector<RenderCallback> render_callbacks;
         std::vector<Mat4> camera_views;
         std::vector<Mat4> camera_projections;
         std::vector<Mat4> camera_view_projections;
+        std::vector<Frustum> camera_frustums;
     } render_state{};
 
     struct ImmediateCommand {
@@ -131,10 +204,57 @@ struct RendererVulkan : public Renderer {
     struct MaterialTypeData {
         uint id;
         GPUBuffer buffer;
+        // Frees a slot of the type's material pool
+        void (*free)(uint p_id);
+    };
+
+    // Device local buffer that meshes own byte ranges of. Grows by moving to a
+    // larger buffer, the old one is retired until no frame uses it anymore.
+    // Like mesh uploads, the copy is recorded into the frame when growing
+    // while uploads are recorded, and only blocks outside of that.
+    struct GeometryBuffer {
+        GPUBuffer buffer{};
+        RangeAllocator allocator;
+        VkBufferUsageFlags usage;
+        VkDeviceSize initial_capacity;
+    };
+
+    // Released once the frames in flight when they were retired finished
+    struct RetiredBuffer {
+        GPUBuffer buffer;
+        uint frames_left;
+    };
+    struct RetiredMesh {
+        GPUMesh mesh;
+        uint frames_left;
+    };
+    // Textures and materials keep their handle until released, the index
+    // is what shaders use and must not be reused while frames read it
+    struct RetiredTexture {
+        Handle<GPUImage> handle;
+        uint frames_left;
+    };
+    struct RetiredMaterial {
+        Handle<GPUMaterial> handle;
+        uint frames_left;
     };
+    std::vector<RetiredBuffer> retired_buffers;
+    std::vector<RetiredMesh> retired_meshes;
+    std::vector<RetiredTexture> retired_textures;
+    std::vector<RetiredMaterial> retired_materials;
+    // The frame's command buffer between BeginUploads and EndUploads
+    VkCommandBuffer upload_cmd = VK_NULL_HANDLE;
 
     struct GlobalResources {
         Pool<GPUMesh> meshes;
+        GeometryBuffer vertices{
+            .usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+            .initial_capacity = 64 * 1024 * 1024,
+        };
+        GeometryBuffer indices{
+            .usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            .initial_capacity = 16 * 1024 * 1024,
+        };
         Pool<GPUImage> textures;
         Pool<GPUMaterial> materials;
 
@@ -180,7 +300,7 @@ struct RendererVulkan : public Renderer {
     template <typename MaterialType>
     Handle<GPUMaterial> CreateMaterial(const MaterialType& p_material);
 
-    virtual void DestroyMaterial(Handle<GPU_PBRMaterial> p_handle) final override;
+    virtual void DestroyMaterial(Handle<GPUMaterial> p_handle) final override;
 
     void OnWindowResized(uint p_width, uint p_height) final override;
     void OnViewportResized(Viewport& p_viewport, uint p_width, uint p_height) const;
@@ -191,8 +311,32 @@ struct RendererVulkan : public Renderer {
         auto shader = std::make_shared<S>();
         shader->Initialize(*this);
         shaders[std::type_index(typeid(S))] = shader;
+        shader_order.push_back(shader.get());
+        if constexpr (std::is_base_of_v<MeshShader, S>) {
+            for (const bool transparent : {false, true}) {
+                const MeshShader::Pass pass = shader->GetPass(transparent);
+                const bool exists = std::ranges::any_of(draw_queues, [&](const DrawQueue& p_queue) {
+                    return p_queue.shader == shader.get() && p_queue.pass == pass;
+                });
+                if (!exists) {
+                    assert(draw_queues.size() < DrawKey::MAX_QUEUES);
+                    draw_queues.push_back(DrawQueue{.shader = shader.get(), .pass = pass});
+                }
+            }
+        }
     }
 
+    static constexpr uint INVALID_DRAW_QUEUE = ~0u;
+
+    // Index of the queue of the mesh shader with the given id and the pass
+    // it draws opaque or blended materials in. Resolved once so that
+    // submitting doesn't have to look the shader up.
+    uint GetDrawQueue(StringID p_shader_id, bool p_transparent = false) const;
+    inline void SubmitMesh(uint p_draw_queue, const MeshShader::DrawObject& p_object) {
+        draw_queues[p_draw_queue].objects.push_back(p_object);
+    }
+    const DrawStats& GetDrawStats() const { return last_draw_stats; }
+
     template <IsShader S>
     Ref<S> GetShader() {
         return std::static_pointer_cast<S>(shaders[std::type_index(typeid(S))]);
@@ -202,6 +346,9 @@ struct RendererVulkan : public Renderer {
     inline void RegisterMaterialType() {
         MaterialTypeData material_type_data{
             .id = (uint)resources.material_addresses.size(),
+            .free = [](uint p_id) {
+                materials<MaterialType>.FreeAt(p_id);
+            },
         };
         material_type_data.buffer = CreateBuffer(
                                         sizeof(MaterialType) * 1000,
@@ -271,9 +418,18 @@ struct RendererVulkan : public Renderer {
     void DestroyImage(GPUImage& p_image) const;
 
     Result<> InitializeGlobalResources();
+    Result<> CreateCullPipelines();
     void RecordCommands(const CommandBufferVulkan& cmd, uint p_next_image_index);
     void RenderImGui(CommandBufferVulkan* cmd, uint p_next_image_index) const;
-    void RenderViewport(const CommandBufferVulkan& cmd, const Viewport& p_viewport, uint p_next_image_index);
+    void RenderViewport(const CommandBufferVulkan& cmd, Viewport& p_viewport, uint p_viewport_id, uint p_next_image_index);
+    // Sorts the objects of all draw queues by draw key and writes them, their
+    // groups and the batches to draw
+    void WriteDrawObjects(uint p_camera_id);
+    // Writes the draw objects, culls them against the camera's frustum on the
+    // GPU and writes an instanced draw per group with visible objects.
+    // Records outside of rendering.
+    void CullMeshQueues(const CommandBufferVulkan& cmd, uint p_camera_id);
+    void DrawMeshQueues(const CommandBufferVulkan& cmd, uint p_camera_id);
     void SetDebugName(uint64_t p_handle, VkObjectType p_type, const std::string& p_name) const;
 
     Result<> ViewportCreateImages(Viewport& p_viewport) const;
@@ -284,14 +440,33 @@ struct RendererVulkan : public Renderer {
     void ViewportMoveCamera(uint p_viewport_id, const Vec3& p_offset) final override;
     void ViewportRotateCamera(uint p_viewport_id, float p_yaw, float p_pitch) final override;
     Quaternion ViewportGetCameraRotation(uint p_viewport_id) final override;
+    const SceneBounds::CullingStats& ViewportGetCullingStats(uint p_viewport_id) const;
 
     Result<> ImmediateSubmit(std::function<void(CommandBufferVulkan p_cmd)>&& function) const;
+    // Records p_function ahead of the frame's draws while uploads are
+    // recorded, submits it and waits otherwise
+    Result<> SubmitUpload(std::function<void(CommandBufferVulkan p_cmd)>&& p_function);
+    // Destroys a buffer passed to SubmitUpload once it has been read
+    void ReleaseStagingBuffer(const GPUBuffer& p_buffer);
+    // Uploads between these are recorded into cmd, see SubmitUpload
+    void BeginUploads(const CommandBufferVulkan& cmd);
+    void EndUploads(const CommandBufferVulkan& cmd);
+
+    // Offset of a new range of the buffer, growing it if no free range fits
+    Result<VkDeviceSize> AllocateGeometry(GeometryBuffer& r_geometry, VkDeviceSize p_size, VkDeviceSize p_alignment);
+    Result<> GrowGeometry(GeometryBuffer& r_geometry, VkDeviceSize p_capacity);
+    // Replaces the frame's GPU driven draw buffers with ones for p_capacity
+    // objects. The old buffers are retired, so it can be called mid-frame.
+    Result<> CreateDrawBuffers(FrameData& r_frame, uint p_capacity);
+    // Called once the current frame's fence has signaled
+    void ReleaseRetiredResources();
+    VkDeviceAddress GetVertexAddress(const GPUMesh& p_mesh) const { return resources.vertices.buffer.address + p_mesh.vertex_offset; }
 
     template <typename VertexType>
-    Result<GPUMesh> UploadMeshToGPU(const std::vector<VertexType>& p_vertices, const std::vector<uint>& p_indices) const;
+    Result<GPUMesh> UploadMeshToGPU(const std::vector<VertexType>& p_vertices, const std::vector<uint>& p_indices);
 
-    Result<GPUMesh> UploadMeshToGPU(const CPUMesh& mesh) const;
-    Result<GPUMesh> UploadMeshToGPU(const glTF::Primitive& primitive) const;
+    Result<GPUMesh> UploadMeshToGPU(const CPUMesh& mesh);
+    Result<GPUMesh> UploadMeshToGPU(const glTF::Primitive& primitive);
     Result<GPUImage> UploadTextureToGPU(const Texture& p_texture);
 
     static VkSampleCountFlagBits SampleCountFromMSAA(MSAA p_msaa);
@@ -315,7 +490,7 @@ Handle<GPUMaterial> RendererVulkan::CreateMaterial(const MaterialType& p_materia
     void* data = staging_buffer.allocation.info.pMappedData;
     memcpy(data, &p_material, sizeof(MaterialType));
 
-    ImmediateSubmit([&](CommandBufferVulkan cmd) {
+    SubmitUpload([&](CommandBufferVulkan cmd) {
         const VkBufferCopy buffer_copy{
             .dstOffset = (handle.index) * sizeof(MaterialType),
             .size = sizeof(MaterialType),
@@ -323,7 +498,7 @@ Handle<GPUMaterial> RendererVulkan::CreateMaterial(const MaterialType& p_materia
         vkCmdCopyBuffer(cmd.GetHandle(), staging_buffer.handle, material_type_data.buffer.handle, 1, &buffer_copy);
     });
 
-    vmaDestroyBuffer(ctx.allocator, staging_buffer.handle, staging_buffer.allocation.handle);
+    ReleaseStagingBuffer(staging_buffer);
     return resources.materials.Allocate({
         .type = material_type_data.id,
         .id = handle.index,
@@ -332,33 +507,28 @@ Handle<GPUMaterial> RendererVulkan::CreateMaterial(const MaterialType& p_materia
 
 template <typename VertexType>
 inline Result<GPUMesh>
-RendererVulkan::UploadMeshToGPU(const std::vector<VertexType>& p_vertices, const std::vector<uint>& p_indices) const {
+RendererVulkan::UploadMeshToGPU(const std::vector<VertexType>& p_vertices, const std::vector<uint>& p_indices) {
     GPUMesh gpu_mesh{};
-    const uint vertex_buffer_size = p_vertices.size() * sizeof(VertexType);
-    const size_t index_buffer_size = p_indices.size() * sizeof(uint);
+    const VkDeviceSize vertex_buffer_size = p_vertices.size() * sizeof(VertexType);
+    const VkDeviceSize index_buffer_size = p_indices.size() * sizeof(uint);
 
     gpu_mesh.index_count = p_indices.size();
+    gpu_mesh.vertex_size = vertex_buffer_size;
+    if (!p_vertices.empty()) {
+        gpu_mesh.bounds = Math::ComputeBounds(&p_vertices[0].position, p_vertices.size(), sizeof(VertexType));
+    }
 
-    // Vertices
-    const auto vertex_buffer_result = CreateBuffer(
-        vertex_buffer_size,
-        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-        VMA_MEMORY_USAGE_GPU_ONLY);
-    CHECK_RET(vertex_buffer_result);
-    gpu_mesh.vertex_buffer = vertex_buffer_result.value();
-    const VkBufferDeviceAddressInfo vertex_buffer_address_info{
-        .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
-        .buffer = gpu_mesh.vertex_buffer.handle,
-    };
-    gpu_mesh.vertex_buffer.address = vkGetBufferDeviceAddress(ctx.device, &vertex_buffer_address_info);
+    // Vertices are read through their address, aligned for their vector members
+    const auto vertex_offset_result = AllocateGeometry(resources.vertices, vertex_buffer_size, 16);
+    CHECK_RET(vertex_offset_result);
+    gpu_mesh.vertex_offset = vertex_offset_result.value();
 
-    // Indices
-    const auto index_buffer_result = CreateBuffer(
-        index_buffer_size,
-        VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-        VMA_MEMORY_USAGE_GPU_ONLY);
-    CHECK_RET(index_buffer_result);
-    gpu_mesh.index_buffer = index_buffer_result.value();
+    const auto index_offset_result = AllocateGeometry(resources.indices, index_buffer_size, sizeof(uint));
+    if (!index_offset_result) {
+        resources.vertices.allocator.Free(gpu_mesh.vertex_offset, vertex_buffer_size);
+    }
+    CHECK_RET(index_offset_result);
+    gpu_mesh.first_index = index_offset_result.value() / sizeof(uint);
 
     // Staging
     GPUBuffer staging_buffer{};
@@ -366,6 +536,10 @@ RendererVulkan::UploadMeshToGPU(const std::vector<VertexType>& p_vertices, const
         (vertex_buffer_size + index_buffer_size),
         VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
         VMA_MEMORY_USAGE_CPU_COPY);
+    if (!staging_buffer_result) {
+        resources.vertices.allocator.Free(gpu_mesh.vertex_offset, vertex_buffer_size);
+        resources.indices.allocator.Free(gpu_mesh.first_index * sizeof(uint), index_buffer_size);
+    }
     CHECK_RET(staging_buffer_result);
     staging_buffer = staging_buffer_result.value();
 
@@ -373,20 +547,25 @@ RendererVulkan::UploadMeshToGPU(const std::vector<VertexType>& p_vertices, const
     memcpy(data, p_vertices.data(), vertex_buffer_size);
     memcpy((char*)data + vertex_buffer_size, p_indices.data(), index_buffer_size);
 
-    ImmediateSubmit([&](CommandBufferVulkan cmd) {
-        const VkBufferCopy vertex_copy{
-            .size = vertex_buffer_size,
-        };
-        vkCmdCopyBuffer(cmd.GetHandle(), staging_buffer.handle, gpu_mesh.vertex_buffer.handle, 1, &vertex_copy);
-
-        const VkBufferCopy index_copy{
-            .srcOffset = vertex_buffer_size,
-            .size = index_buffer_size,
-        };
-        vkCmdCopyBuffer(cmd.GetHandle(), staging_buffer.handle, gpu_mesh.index_buffer.handle, 1, &index_copy);
+    SubmitUpload([&](CommandBufferVulkan cmd) {
+        if (vertex_buffer_size > 0) {
+            const VkBufferCopy vertex_copy{
+                .dstOffset = gpu_mesh.vertex_offset,
+                .size = vertex_buffer_size,
+            };
+            vkCmdCopyBuffer(cmd.GetHandle(), staging_buffer.handle, resources.vertices.buffer.handle, 1, &vertex_copy);
+        }
+        if (index_buffer_size > 0) {
+            const VkBufferCopy index_copy{
+                .srcOffset = vertex_buffer_size,
+                .dstOffset = gpu_mesh.first_index * sizeof(uint),
+                .size = index_buffer_size,
+            };
+            vkCmdCopyBuffer(cmd.GetHandle(), staging_buffer.handle, resources.indices.buffer.handle, 1, &index_copy);
+        }
     });
 
-    vmaDestroyBuffer(ctx.allocator, staging_buffer.handle, staging_buffer.allocation.handle);
+    ReleaseStagingBuffer(staging_buffer);
 
     return gpu_mesh;
 }
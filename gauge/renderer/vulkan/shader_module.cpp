@@ -9,13 +9,13 @@ using namespace Gauge;
 
 Result<ShaderModule>
 ShaderModule::FromFile(const VulkanContext& ctx, std::string p_file_name) {
-    auto shader_code_result = FileSystem::ReadFile(p_file_name);
+    auto shader_code_result = FileSystem::Map(p_file_name);
     CHECK_RET(shader_code_result);
-    return ShaderModule::FromCode(ctx, shader_code_result.value());
+    return ShaderModule::FromCode(ctx, shader_code_result->GetData());
 }
 
 Result<ShaderModule>
-ShaderModule::FromCode(const VulkanContext& ctx, std::vector<char> p_code) {
+ShaderModule::FromCode(const VulkanContext& ctx, std::span<const char> p_code) {
     ShaderModule shader_module{};
     VkShaderModuleCreateInfo shader_module_info{
         .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
@@ -5,8 +5,8 @@
 #include <gauge/renderer/vulkan/common.hpp>
 
 #include <volk.h>
+#include <span>
 #include <string>
-#include <vector>
 
 namespace Gauge {
 
@@ -15,7 +15,7 @@ struct ShaderModule {
 
    public:
     static Result<ShaderModule> FromFile(const VulkanContext& ctx, std::string p_file_name);
-    static Result<ShaderModule> FromCode(const VulkanContext& ctx, std::vector<char> p_code);
+    static Result<ShaderModule> FromCode(const VulkanContext& ctx, std::span<const char> p_code);
 };
 
 }  // namespace Gauge
\ No newline at end of file
@@ -0,0 +1,201 @@
+#include "baked_scene.hpp"
+
+#include <gauge/components/aabb_gizmo.hpp>
+#include <gauge/core/resource_manager.hpp>
+#include <gauge/core/string_id.hpp>
+#include <gauge/scene/node.hpp>
+#include <gauge/scene/property_blob.hpp>
+#include <gauge/scene/scene.hpp>
+#include <gauge/scene/yaml.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <print>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace Gauge;
+
+struct BakedScene::ComponentInitializer {
+    StringID type;
+    PropertyBlob blob;
+    YAML::Node yaml;
+    Component::BinaryCreateFunction create_binary = nullptr;
+    Component::CreateFunction create = nullptr;
+};
+
+namespace {
+
+bool FitsIn(uint64_t p_offset, uint64_t p_size, uint64_t p_total) {
+    return p_offset <= p_total && p_size <= p_total - p_offset;
+}
+
+}  // namespace
+
+bool BakedScene::IsBaked(std::span<const char> p_data) {
+    return p_data.size() >= sizeof(Header) && std::memcmp(p_data.data(), MAGIC, sizeof(MAGIC)) == 0;
+}
+
+Result<BakedScene> BakedScene::Open(FileSystem::MappedFile p_file) {
+    if (!IsBaked(p_file.GetData())) {
+        return Error("Not a baked scene");
+    }
+
+    Header header;
+    std::memcpy(&header, p_file.Data(), sizeof(header));
+    if (header.version != VERSION) {
+        return Error(std::format("Baked scene has version {}, expected {}", header.version, VERSION));
+    }
+    const uint64_t size = p_file.Size();
+    if (!FitsIn(header.nodes_offset, uint64_t(header.node_count) * sizeof(NodeEntry), size) ||
+        !FitsIn(header.components_offset, uint64_t(header.component_count) * sizeof(ComponentEntry), size) ||
+        !FitsIn(header.strings_offset, uint64_t(header.string_count) * sizeof(StringEntry), size) ||
+        !FitsIn(header.data_offset, header.data_size, size)) {
+        return Error("Baked scene is truncated");
+    }
+    if (header.node_count == 0) {
+        return Error("Baked scene has no nodes");
+    }
+
+    BakedScene scene;
+    scene.file = std::move(p_file);
+    const char* base = scene.file.Data();
+    scene.nodes = {reinterpret_cast<const NodeEntry*>(base + header.nodes_offset), header.node_count};
+    scene.components = {reinterpret_cast<const ComponentEntry*>(base + header.components_offset), header.component_count};
+    scene.data = {base + header.data_offset, header.data_size};
+
+    for (uint32_t index = 0; index < scene.nodes.size(); ++index) {
+        const NodeEntry& node = scene.nodes[index];
+        if ((index == 0) != (node.parent == INVALID_INDEX) || (index > 0 && node.parent >= index)) {
+            return Error(std::format("Node {} of baked scene has an invalid parent", index));
+        }
+        if (!FitsIn(node.first_component, node.component_count, scene.components.size())) {
+            return Error(std::format("Node {} of baked scene has invalid components", index));
+        }
+    }
+
+    // Interning up front means nothing is hashed while instantiating
+    const std::span<const StringEntry> strings(reinterpret_cast<const StringEntry*>(base + header.strings_offset), header.string_count);
+    for (const StringEntry& string : strings) {
+        if (!FitsIn(string.offset, string.length, scene.data.size())) {
+            return Error("String table exceeds the baked scene");
+        }
+        StringID::Register(std::string_view(scene.data.data() + string.offset, string.length), string.id);
+    }
+
+    // Factories are looked up and parameters parsed here rather than for
+    // every instance. Types without a binary factory get their parameters
+    // converted to YAML once.
+    auto initializers = std::make_shared<std::vector<ComponentInitializer>>();
+    initializers->reserve(scene.components.size());
+    for (const ComponentEntry& component : scene.components) {
+        if (!FitsIn(component.offset, component.size, scene.data.size())) {
+            return Error("Component parameters exceed the baked scene");
+        }
+        const std::span<const char> parameters = scene.data.subspan(component.offset, component.size);
+        ComponentInitializer& initializer = initializers->emplace_back();
+        initializer.type = StringID::FromHash(component.type);
+
+        if (component.encoding == Encoding::PROPERTIES) {
+            auto blob = PropertyBlob::FromData(parameters);
+            if (!blob) {
+                return Error(std::format("Component {} of baked scene: {}", initializer.type, blob.error()));
+            }
+            initializer.blob = blob.value();
+            initializer.create_binary = Component::FindBinaryCreateFunction(initializer.type);
+            if (initializer.create_binary != nullptr) {
+                continue;
+            }
+            initializer.yaml = initializer.blob.ToYAML();
+        } else {
+            initializer.yaml = YAML::Load(std::string(parameters.data(), parameters.size()));
+        }
+        initializer.create = Component::FindCreateFunction(initializer.type);
+    }
+    scene.initializers = std::move(initializers);
+
+    for (const NodeEntry& node : scene.nodes) {
+        if (node.scene == 0) {
+            scene.local_node_count++;
+        }
+    }
+
+    return scene;
+}
+
+BakedScene::Instancer::Instancer(const BakedScene& p_scene)
+    : scene(&p_scene),
+      instances(p_scene.nodes.size()),
+      batch(p_scene.local_node_count),
+      remaining_bounds(p_scene.nodes.size()) {
+    Node::CreateBatch(batch);
+}
+
+bool BakedScene::Instancer::Step(uint p_count) {
+    // Parents precede their children, so every node can be attached right away
+    const uint32_t node_end = std::min<uint64_t>(uint64_t(next_node) + p_count, scene->nodes.size());
+    for (; next_node < node_end; ++next_node) {
+        const NodeEntry& entry = scene->nodes[next_node];
+        Ref<Node> node;
+
+        if (entry.scene != 0) {
+            node = ResourceManager::Load<Scene>(StringID::FromHash(entry.scene))->Instantiate();
+        } else {
+            node = std::move(batch[next_batch_node++]);
+            node->name = StringID::FromHash(entry.name);
+            if (entry.flags & (HAS_POSITION | HAS_SCALE)) {
+                Transform transform;
+                if (entry.flags & HAS_POSITION) {
+                    transform.position = Vec3(entry.position[0], entry.position[1], entry.position[2]);
+                }
+                if (entry.flags & HAS_SCALE) {
+                    transform.scale = entry.scale;
+                }
+                node->SetTransform(transform);
+            }
+
+            for (uint32_t i = entry.first_component; i < entry.first_component + entry.component_count; ++i) {
+                const ComponentInitializer& initializer = (*scene->initializers)[i];
+                if (initializer.create_binary != nullptr) {
+                    initializer.create_binary(initializer.blob, node);
+                } else if (initializer.create != nullptr) {
+                    initializer.create(initializer.yaml, node);
+                } else {
+                    std::println("Can not load component {}", initializer.type);
+                }
+            }
+        }
+
+        if (entry.parent != INVALID_INDEX) {
+            instances[entry.parent]->AddChild(node);
+        }
+        instances[next_node] = std::move(node);
+    }
+    if (next_node < scene->nodes.size()) {
+        return false;
+    }
+
+    // Children come after their parents, so walking backwards finishes every
+    // subtree's bounds before they are added to the parent's
+    for (uint i = 0; i < p_count && remaining_bounds > 0; ++i) {
+        const uint32_t index = --remaining_bounds;
+        if (scene->nodes[index].scene != 0) {
+            continue;
+        }
+        Node& node = *instances[index];
+        for (const auto& child : node.children) {
+            node.aabb.Grow(child->aabb);
+        }
+        node.AddComponent<AABBGizmo>(node.aabb);
+    }
+    return remaining_bounds == 0;
+}
+
+Ref<Node> BakedScene::Instantiate() const {
+    Instancer instancer(*this);
+    while (!instancer.Step(~0u)) {
+    }
+    return instancer.GetRoot();
+}
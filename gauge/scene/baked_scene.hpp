@@ -0,0 +1,124 @@
+#pragma once
+
+#include <gauge/common.hpp>
+#include <gauge/core/filesystem.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Gauge {
+
+class Node;
+
+// Scene baked by gauge_bake_scene, memory-mapped and instantiated without
+// parsing. Nodes are stored in preorder as a flat table with parent indices,
+// names and paths are pre-interned StringIDs whose strings follow in a table
+// that is registered on open, and component parameters are PropertyBlobs.
+// Layout: Header | nodes | components | strings | data
+//
+// YAML scenes are baked in memory on their first instantiation and then used
+// as a prototype, see Scene::Instantiate.
+struct BakedScene {
+    static constexpr char MAGIC[4] = {'G', 'S', 'C', 'N'};
+    static constexpr uint VERSION = 1;
+    static constexpr uint32_t INVALID_INDEX = ~0u;
+
+    enum class Encoding : uint32_t {
+        PROPERTIES = 0,
+        // Parameters that don't fit a PropertyBlob, stored as YAML text
+        YAML = 1,
+    };
+
+    enum NodeFlags : uint32_t {
+        HAS_POSITION = 1,
+        HAS_SCALE = 2,
+    };
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t node_count;
+        uint32_t component_count;
+        uint32_t string_count;
+        uint32_t reserved;
+        uint64_t nodes_offset;
+        uint64_t components_offset;
+        uint64_t strings_offset;
+        uint64_t data_offset;
+        uint64_t data_size;
+    };
+
+    struct NodeEntry {
+        uint64_t name;
+        // Path of an instanced subscene, 0 if none
+        uint64_t scene;
+        // Always lower than the node's own index
+        uint32_t parent;
+        uint32_t first_component;
+        uint32_t component_count;
+        uint32_t flags;
+        float position[3];
+        float scale;
+    };
+
+    struct ComponentEntry {
+        uint64_t type;
+        // Parameters, relative to the data section
+        uint32_t offset;
+        uint32_t size;
+        Encoding encoding;
+        uint32_t reserved;
+    };
+
+    struct StringEntry {
+        uint64_t id;
+        // Relative to the data section
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    static_assert(sizeof(Header) == 64);
+    static_assert(sizeof(NodeEntry) == 48);
+    static_assert(sizeof(ComponentEntry) == 24);
+    static_assert(sizeof(StringEntry) == 16);
+
+    // Component factory and parameters, resolved once on open
+    struct ComponentInitializer;
+
+    // Instantiates a scene a few nodes at a time, so the work can be spread
+    // over several frames. The scene has to outlive it.
+    class Instancer {
+        const BakedScene* scene;
+        std::vector<Ref<Node>> instances;
+        std::vector<Ref<Node>> batch;
+        uint next_batch_node = 0;
+        uint32_t next_node = 0;
+        // Nodes whose bounds are not finished yet, walked backwards
+        uint32_t remaining_bounds;
+
+       public:
+        // Creates up to p_count nodes, once all exist finishes the bounds of
+        // up to p_count nodes. Returns true once the instance is complete.
+        bool Step(uint p_count);
+        // Root of the nodes created so far
+        Ref<Node> GetRoot() const { return instances[0]; }
+
+        explicit Instancer(const BakedScene& p_scene);
+    };
+
+    FileSystem::MappedFile file;
+    std::span<const NodeEntry> nodes;
+    std::span<const ComponentEntry> components;
+    std::span<const char> data;
+    Ref<const std::vector<ComponentInitializer>> initializers;
+    // Nodes that are not subscene references, created as one batch
+    uint local_node_count = 0;
+
+    static bool IsBaked(std::span<const char> p_data);
+    static Result<BakedScene> Open(FileSystem::MappedFile p_file);
+
+    Ref<Node> Instantiate() const;
+};
+
+}  // namespace Gauge
@@ -1,69 +1,119 @@
 #include "node.hpp"
 
 #include <gauge/components/component.hpp>
+#include <gauge/scene/update_scheduler.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <new>
 
 using namespace Gauge;
 
 Pool<std::weak_ptr<Node>> Node::pool;
 
+namespace {
+
+// Start of a batch allocation, followed by the nodes
+struct alignas(Node) NodeBatch {
+    std::atomic<uint> live_count;
+
+    Node* GetNodes() { return reinterpret_cast<Node*>(this + 1); }
+};
+
+}  // namespace
+
+void Node::CreateBatch(std::span<Ref<Node>> r_nodes) {
+    if (r_nodes.empty()) {
+        return;
+    }
+
+    void* memory = ::operator new(sizeof(NodeBatch) + r_nodes.size() * sizeof(Node), std::align_val_t(alignof(NodeBatch)));
+    NodeBatch* batch = new (memory) NodeBatch{uint(r_nodes.size())};
+    for (uint i = 0; i < r_nodes.size(); ++i) {
+        Node* node = new (batch->GetNodes() + i) Node();
+        // Nodes are still destroyed individually, only the memory is shared
+        r_nodes[i] = Ref<Node>(node, [batch](Node* p_node) {
+            p_node->~Node();
+            if (batch->live_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                batch->~NodeBatch();
+                ::operator delete(batch, std::align_val_t(alignof(NodeBatch)));
+            }
+        });
+        node->self = r_nodes[i];
+        node->handle = pool.Allocate(r_nodes[i]);
+    }
+}
+
 Vec3 Node::GetPosition() const {
-    return local_transform.position;
+    return GetTransform().position;
 }
 
 void Node::SetPosition(Vec3 p_position) {
-    local_transform.position = p_position;
-    RefreshTransform();
+    Transform transform = GetTransform();
+    transform.position = p_position;
+    SetTransform(transform);
 }
 
 void Node::SetPosition(float x, float y, float z) {
-    local_transform.position = Vec3(x, y, z);
-    RefreshTransform();
+    Transform transform = GetTransform();
+    transform.position = Vec3(x, y, z);
+    SetTransform(transform);
 }
 
 void Node::Move(Vec3 p_offset) {
-    local_transform.position += p_offset;
-    RefreshTransform();
+    Transform transform = GetTransform();
+    transform.position += p_offset;
+    SetTransform(transform);
 }
 
 void Node::Move(float x, float y, float z) {
-    local_transform.position += Vec3(x, y, z);
-    RefreshTransform();
+    Transform transform = GetTransform();
+    transform.position += Vec3(x, y, z);
+    SetTransform(transform);
 }
 
 float Node::GetScale() const {
-    return local_transform.scale;
+    return GetTransform().scale;
 }
 
 void Node::SetScale(float p_scale) {
-    local_transform.scale = p_scale;
-    RefreshTransform();
+    Transform transform = GetTransform();
+    transform.scale = p_scale;
+    SetTransform(transform);
 }
 
 void Node::ScaleBy(float p_scale) {
-    local_transform.scale *= p_scale;
-    RefreshTransform();
+    Transform transform = GetTransform();
+    transform.scale *= p_scale;
+    SetTransform(transform);
 }
 
 Quaternion Node::GetRotation() const {
-    return local_transform.rotation;
+    return GetTransform().rotation;
 }
 
 void Node::SetRotation(Quaternion p_rotation) {
-    local_transform.rotation = p_rotation;
-    RefreshTransform();
+    Transform transform = GetTransform();
+    transform.rotation = p_rotation;
+    SetTransform(transform);
 }
 
 void Node::Rotate(Vec3 p_axis, float p_angle) {
-    local_transform.rotation *= Quaternion(p_axis * p_angle);
-    RefreshTransform();
+    Transform transform = GetTransform();
+    transform.rotation *= Quaternion(p_axis * p_angle);
+    SetTransform(transform);
 }
 
 Transform Node::GetTransform() const {
-    return local_transform;
+    return TransformHierarchy::Get().GetLocal(transform_id);
+}
+
+void Node::SetTransform(const Transform& p_transform) {
+    TransformHierarchy::Get().SetLocal(transform_id, p_transform);
 }
 
 Transform Node::GetGlobalTransform() const {
-    return global_transform;
+    return TransformHierarchy::Get().GetGlobal(transform_id);
 }
 
 std::vector<Ref<Component>> const& Node::GetComponents() const {
@@ -74,11 +124,25 @@ bool Node::HasParent() const {
     return parent.lock() != nullptr;
 }
 
+bool Node::IsVisibleBelow(const Node& p_root) const {
+    for (const Node* node = this; node != nullptr; node = node->parent_node) {
+        if (!node->visible) {
+            return false;
+        }
+        if (node == &p_root) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void Node::AddChild(const Ref<Node>& p_node) {
     assert(!p_node->HasParent());
     assert(!HasChild(p_node->name));
     children.push_back(p_node);
     p_node->parent = self;
+    p_node->parent_node = this;
+    TransformHierarchy::Get().SetParent(p_node->transform_id, transform_id);
 }
 
 bool Node::HasChild(StringID p_name) const {
@@ -99,27 +163,35 @@ Ref<Node> Node::GetChild(StringID p_name) const {
     return nullptr;
 }
 
+void Node::RemoveChild(const Ref<Node>& p_node) {
+    auto it = std::ranges::find(children, p_node);
+    if (it == children.end()) {
+        return;
+    }
+    p_node->parent.reset();
+    p_node->parent_node = nullptr;
+    TransformHierarchy::Get().SetParent(p_node->transform_id, TransformHierarchy::INVALID_ID);
+    children.erase(it);
+}
+
 void Node::RemoveChildren() {
+    for (const auto& child : children) {
+        child->parent.reset();
+        child->parent_node = nullptr;
+        TransformHierarchy::Get().SetParent(child->transform_id, TransformHierarchy::INVALID_ID);
+    }
     children.clear();
 }
 
 void Node::Update(float delta) {
-    if (!active)
-        return;
-    for (auto& component : components) {
-        if (component->active)
-            component->Update(delta);
-    }
-    for (auto& child : children) {
-        child->Update(delta);
-    }
+    UpdateScheduler::Get().Run(*this, delta);
 }
 
 void Node::Draw() const {
     if (!visible)
         return;
     for (const auto& component : components) {
-        if (component->visible) {
+        if (component->visible && !component->stored_contiguously) {
             component->Draw();
         }
     }
@@ -128,21 +200,6 @@ void Node::Draw() const {
     }
 }
 
-void Node::RefreshTransform() {
-    if (HasParent()) {
-        RefreshTransform(parent.lock()->GetGlobalTransform());
-    } else {
-        RefreshTransform(Transform::IDENTITY);
-    }
-}
-
-void Node::RefreshTransform(Transform const& p_parent_transform) {
-    global_transform = p_parent_transform * local_transform;
-    for (auto child : children) {
-        child->RefreshTransform(global_transform);
-    }
-}
-
 bool Node::ProcessEvent(const SDL_Event& event) {
     for (auto component : components) {
         if (component->HandleEvent(event)) {
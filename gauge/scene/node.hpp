@@ -3,12 +3,15 @@
 #include <SDL3/SDL_events.h>
 #include <gauge/common.hpp>
 #include <gauge/components/component.hpp>
+#include <gauge/components/component_storage.hpp>
 #include <gauge/math/transform.hpp>
 #include <gauge/renderer/aabb.hpp>
+#include <gauge/scene/scene_bounds.hpp>
+#include <gauge/scene/transform_hierarchy.hpp>
 #include <memory>
 #include <print>
+#include <span>
 #include <string>
-#include <typeindex>
 
 namespace Gauge {
 
@@ -17,8 +20,8 @@ using NodeHandle = Handle<std::weak_ptr<Node>>;
 class Node {
    public:
     StringID name;
-    Transform local_transform;
-    Transform global_transform;
+    // Entry in the TransformHierarchy holding the local and global transform
+    uint transform_id = TransformHierarchy::INVALID_ID;
     AABB aabb;
 
     std::vector<Ref<Node>> children;
@@ -26,9 +29,10 @@ class Node {
     std::weak_ptr<Node> self;
 
    protected:
-    std::unordered_map<std::type_index, Ref<Component>> component_table;
     std::vector<Ref<Component>> components;
     static Pool<std::weak_ptr<Node>> pool;
+    // Same as parent, for walks up the tree that cannot afford to lock it
+    Node* parent_node = nullptr;
 
    public:
     bool active = true;
@@ -52,19 +56,22 @@ class Node {
     void Rotate(Vec3 p_axis, float p_angle);
 
     Transform GetTransform() const;
+    void SetTransform(const Transform& p_transform);
     Transform GetGlobalTransform() const;
-    void RefreshTransform();
-    void RefreshTransform(Transform const& p_parent_transform);
 
     std::vector<Ref<Component>> const& GetComponents() const;
 
     bool HasParent() const;
+    // Whether this node and all its ancestors up to p_root are visible
+    bool IsVisibleBelow(const Node& p_root) const;
     void AddChild(const Ref<Node>& p_node);
     bool HasChild(StringID p_name) const;
     Ref<Node> GetChild(StringID p_name) const;
+    void RemoveChild(const Ref<Node>& p_node);
     void RemoveChildren();
 
     void Draw() const;
+    // Updates the components of this subtree, see UpdateScheduler
     void Update(float delta);
     bool ProcessEvent(const SDL_Event& event);
     void Cleanup();
@@ -72,26 +79,38 @@ class Node {
     template <IsComponent C>
     void AddComponent(Ref<C> p_component) {
         p_component->SetNode(this);
+        p_component->type = GetComponentType<C>();
         components.push_back(p_component);
-        component_table[std::type_index(typeid(C))] = p_component;
         p_component->Initialize();
     }
 
+    // Types that set CONTIGUOUS_STORAGE are allocated from their ComponentStorage
     template <IsComponent C, typename... Args>
     Ref<C> AddComponent(Args... p_constructor_arguments) {
-        auto component = std::make_shared<C>(p_constructor_arguments...);
+        Ref<C> component;
+        if constexpr (IsContiguousComponent<C>) {
+            component = ComponentStorage<C>::Get().Create(p_constructor_arguments...);
+        } else {
+            component = std::make_shared<C>(p_constructor_arguments...);
+        }
         AddComponent(component);
         return component;
     }
 
+    // Nodes only have a handful of components, a linear search beats hashing
     template <IsComponent C>
-    Ref<C> GetComponent() {
-        return std::static_pointer_cast<C>(component_table[std::type_index(typeid(C))]);
+    Ref<C> GetComponent() const {
+        for (auto it = components.rbegin(); it != components.rend(); ++it) {
+            if ((*it)->type == GetComponentType<C>()) {
+                return std::static_pointer_cast<C>(*it);
+            }
+        }
+        return nullptr;
     }
 
     template <IsComponent C>
-    bool HasComponent() {
-        return component_table.contains(std::type_index(typeid(C)));
+    bool HasComponent() const {
+        return GetComponent<C>() != nullptr;
     }
 
     static Ref<Node> Create(const std::string& p_name = "[Node]") {
@@ -102,6 +121,10 @@ class Node {
         return node;
     }
 
+    // Constructs all nodes in a single allocation, which is released once the
+    // last of them is destroyed
+    static void CreateBatch(std::span<Ref<Node>> r_nodes);
+
     static std::weak_ptr<Node> Get(NodeHandle p_handle) {
         auto pointer = pool.Get(p_handle);
         if (pointer == nullptr) {
@@ -110,11 +133,20 @@ class Node {
         return *pointer;
     }
 
-    Node(const std::string& p_name = "[Node]") : name(p_name) {};
+    Node(const std::string& p_name = "[Node]") : name(p_name), transform_id(TransformHierarchy::Get().Create()) {};
     ~Node() {
         if (handle.index > 0) {
             pool.Free(handle);
         }
+        SceneBounds::Get().Remove(transform_id);
+        TransformHierarchy::Get().Destroy(transform_id);
+        for (const auto& child : children) {
+            child->parent_node = nullptr;
+        }
+        // Components kept alive elsewhere must not reach back to this node
+        for (const auto& component : components) {
+            component->node = nullptr;
+        }
     }
 };
 
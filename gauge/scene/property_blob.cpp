@@ -0,0 +1,141 @@
+#include "property_blob.hpp"
+
+#include <yaml-cpp/yaml.h>
+
+#include <format>
+
+using namespace Gauge;
+
+namespace {
+
+constexpr size_t VALUE_ALIGNMENT = 8;
+
+size_t ValueSize(const PropertyBlob::Property& p_property) {
+    switch (p_property.type) {
+        case PropertyBlob::Type::BOOL:
+            return sizeof(uint32_t);
+        case PropertyBlob::Type::INT:
+            return sizeof(int64_t);
+        case PropertyBlob::Type::FLOAT:
+            return p_property.count * sizeof(float);
+        case PropertyBlob::Type::STRING:
+            return p_property.count;
+    }
+    return SIZE_MAX;
+}
+
+}  // namespace
+
+Result<PropertyBlob> PropertyBlob::FromData(std::span<const char> p_data) {
+    PropertyBlob blob;
+    blob.data = p_data;
+    if (p_data.empty()) {
+        return blob;
+    }
+
+    Header header;
+    if (p_data.size() < sizeof(Header)) {
+        return Error("Property blob is truncated");
+    }
+    std::memcpy(&header, p_data.data(), sizeof(header));
+    if (sizeof(Header) + size_t(header.property_count) * sizeof(Property) > p_data.size()) {
+        return Error("Property table exceeds the blob");
+    }
+    blob.properties = {reinterpret_cast<const Property*>(p_data.data() + sizeof(Header)), header.property_count};
+
+    for (const Property& property : blob.properties) {
+        const size_t size = ValueSize(property);
+        if (size == SIZE_MAX || property.offset > p_data.size() || size > p_data.size() - property.offset) {
+            return Error(std::format("Property {} exceeds the blob", StringID::FromHash(property.key)));
+        }
+    }
+    return blob;
+}
+
+const PropertyBlob::Property* PropertyBlob::Find(StringID p_key) const {
+    for (const Property& property : properties) {
+        if (property.key == p_key.id) {
+            return &property;
+        }
+    }
+    return nullptr;
+}
+
+YAML::Node PropertyBlob::ToYAML() const {
+    YAML::Node node(YAML::NodeType::Map);
+    for (const Property& property : properties) {
+        const std::string& key = StringID::FromHash(property.key);
+        const char* value = data.data() + property.offset;
+        switch (property.type) {
+            case Type::BOOL: {
+                node[key] = Get<bool>(StringID::FromHash(property.key), false);
+            } break;
+            case Type::INT: {
+                node[key] = Get<int64_t>(StringID::FromHash(property.key), 0);
+            } break;
+            case Type::FLOAT: {
+                if (property.count == 1) {
+                    node[key] = Get<float>(StringID::FromHash(property.key), 0.0f);
+                    break;
+                }
+                YAML::Node sequence(YAML::NodeType::Sequence);
+                for (uint i = 0; i < property.count; ++i) {
+                    float element;
+                    std::memcpy(&element, value + i * sizeof(float), sizeof(float));
+                    sequence.push_back(element);
+                }
+                node[key] = sequence;
+            } break;
+            case Type::STRING: {
+                node[key] = std::string(value, property.count);
+            } break;
+        }
+    }
+    return node;
+}
+
+void PropertyBlobWriter::Add(StringID p_key, PropertyBlob::Type p_type, uint32_t p_count, const void* p_value, size_t p_size) {
+    values.resize((values.size() + VALUE_ALIGNMENT - 1) / VALUE_ALIGNMENT * VALUE_ALIGNMENT);
+    properties.push_back(PropertyBlob::Property{
+        .key = p_key.id,
+        .type = p_type,
+        .count = p_count,
+        // Relative to the values for now, fixed up in Finish
+        .offset = uint32_t(values.size()),
+    });
+    values.insert(values.end(), static_cast<const char*>(p_value), static_cast<const char*>(p_value) + p_size);
+}
+
+void PropertyBlobWriter::AddBool(StringID p_key, bool p_value) {
+    const uint32_t value = p_value ? 1 : 0;
+    Add(p_key, PropertyBlob::Type::BOOL, 1, &value, sizeof(value));
+}
+
+void PropertyBlobWriter::AddInt(StringID p_key, int64_t p_value) {
+    Add(p_key, PropertyBlob::Type::INT, 1, &p_value, sizeof(p_value));
+}
+
+void PropertyBlobWriter::AddFloats(StringID p_key, std::span<const float> p_values) {
+    Add(p_key, PropertyBlob::Type::FLOAT, p_values.size(), p_values.data(), p_values.size_bytes());
+}
+
+void PropertyBlobWriter::AddString(StringID p_key, std::string_view p_value) {
+    Add(p_key, PropertyBlob::Type::STRING, p_value.size(), p_value.data(), p_value.size());
+}
+
+std::vector<char> PropertyBlobWriter::Finish() const {
+    const PropertyBlob::Header header{
+        .property_count = uint32_t(properties.size()),
+    };
+    const size_t values_offset = sizeof(header) + properties.size() * sizeof(PropertyBlob::Property);
+
+    std::vector<char> blob(values_offset + values.size());
+    std::memcpy(blob.data(), &header, sizeof(header));
+    for (size_t i = 0; i < properties.size(); ++i) {
+        PropertyBlob::Property property = properties[i];
+        property.offset += values_offset;
+        std::memcpy(blob.data() + sizeof(header) + i * sizeof(property), &property, sizeof(property));
+    }
+    std::memcpy(blob.data() + values_offset, values.data(), values.size());
+    return blob;
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <gauge/common.hpp>
+#include <gauge/core/string_id.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace YAML {
+class Node;
+}
+
+namespace Gauge {
+
+// Component parameters in a baked scene: a table of typed properties keyed by
+// StringID, followed by their values. Reading a property is a scan over a few
+// integer keys and a copy, nothing is parsed.
+// Layout: Header | Property[count] | values
+class PropertyBlob {
+   public:
+    enum class Type : uint32_t {
+        BOOL = 0,
+        INT = 1,
+        // One or more floats, vectors are stored as float arrays
+        FLOAT = 2,
+        STRING = 3,
+    };
+
+    struct Header {
+        uint32_t property_count;
+        uint32_t reserved;
+    };
+
+    struct Property {
+        uint64_t key;
+        Type type;
+        // Number of floats or characters, 1 otherwise
+        uint32_t count;
+        // From the start of the blob
+        uint32_t offset;
+        uint32_t reserved;
+    };
+
+    static_assert(sizeof(Header) == 8);
+    static_assert(sizeof(Property) == 24);
+
+   private:
+    std::span<const char> data;
+    std::span<const Property> properties;
+
+   public:
+    static Result<PropertyBlob> FromData(std::span<const char> p_data);
+
+    const Property* Find(StringID p_key) const;
+    bool Has(StringID p_key) const { return Find(p_key) != nullptr; }
+
+    // Returns p_default if the property is missing or has a different type
+    template <typename T>
+    T Get(StringID p_key, T p_default) const;
+
+    // For components that only have a YAML constructor
+    YAML::Node ToYAML() const;
+
+    PropertyBlob() = default;
+};
+
+// Builds a PropertyBlob, used by the scene baker
+class PropertyBlobWriter {
+    std::vector<PropertyBlob::Property> properties;
+    std::vector<char> values;
+
+    void Add(StringID p_key, PropertyBlob::Type p_type, uint32_t p_count, const void* p_value, size_t p_size);
+
+   public:
+    void AddBool(StringID p_key, bool p_value);
+    void AddInt(StringID p_key, int64_t p_value);
+    void AddFloats(StringID p_key, std::span<const float> p_values);
+    void AddString(StringID p_key, std::string_view p_value);
+
+    std::vector<char> Finish() const;
+};
+
+template <typename T>
+T PropertyBlob::Get(StringID p_key, T p_default) const {
+    const Property* property = Find(p_key);
+    if (property == nullptr) {
+        return p_default;
+    }
+    const char* value = data.data() + property->offset;
+
+    if constexpr (std::is_same_v<T, bool>) {
+        if (property->type != Type::BOOL) {
+            return p_default;
+        }
+        uint32_t result;
+        std::memcpy(&result, value, sizeof(result));
+        return result != 0;
+    } else if constexpr (std::is_integral_v<T>) {
+        if (property->type != Type::INT) {
+            return p_default;
+        }
+        int64_t result;
+        std::memcpy(&result, value, sizeof(result));
+        return static_cast<T>(result);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        if (property->type == Type::INT) {
+            int64_t result;
+            std::memcpy(&result, value, sizeof(result));
+            return static_cast<T>(result);
+        }
+        if (property->type != Type::FLOAT || property->count != 1) {
+            return p_default;
+        }
+        float result;
+        std::memcpy(&result, value, sizeof(result));
+        return static_cast<T>(result);
+    } else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+        if (property->type != Type::STRING) {
+            return p_default;
+        }
+        return T(value, property->count);
+    } else {
+        // Vectors
+        if (property->type != Type::FLOAT || property->count != uint32_t(T::length())) {
+            return p_default;
+        }
+        T result;
+        for (int i = 0; i < T::length(); ++i) {
+            std::memcpy(&result[i], value + i * sizeof(float), sizeof(float));
+        }
+        return result;
+    }
+}
+
+}  // namespace Gauge
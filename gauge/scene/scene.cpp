@@ -1,17 +1,47 @@
 #include "scene.hpp"
 
 #include <gauge/components/aabb_gizmo.hpp>
+#include <gauge/core/filesystem.hpp>
 #include <gauge/core/resource_manager.hpp>
 #include <gauge/core/string_id.hpp>
 #include <gauge/scene/node.hpp>
+#include <gauge/scene/scene_baker.hpp>
 #include <gauge/scene/yaml.hpp>
 
 #include <memory>
 #include <string>
+#include <vector>
 
 using namespace Gauge;
 
+namespace {
+
+Result<BakedScene> BakePrototype(const YAML::Node& p_data) {
+    SceneBaker baker;
+    auto result = baker.Bake(p_data);
+    CHECK_RET(result);
+    auto baked = std::make_shared<std::vector<char>>(baker.Finish());
+    return BakedScene::Open(FileSystem::MappedFile(baked->data(), baked->size(), baked));
+}
+
+}  // namespace
+
 Ref<Node> Scene::Instantiate() {
+    // The first instance bakes the YAML into a prototype that this and all
+    // later instances are cloned from
+    if (!baked && state != nullptr) {
+        auto prototype = BakePrototype(*state);
+        if (prototype) {
+            baked = std::move(prototype.value());
+            state = nullptr;
+        } else {
+            std::println("Could not build scene prototype: {}", prototype.error());
+        }
+    }
+
+    if (baked) {
+        return baked->Instantiate();
+    }
     if (state == nullptr) {
         return Node::Create("[Invalid Node]");
     }
@@ -62,8 +92,36 @@ Ref<Node> Scene::FromData(YAML::Node p_data) {
 
 // --- Resource interface ---
 Scene Scene::Load(StringID p_id) {
-    return Scene(std::make_shared<YAML::Node>(YAML::LoadFile(p_id)));
+    auto file = FileSystem::Map(p_id);
+    if (!file) {
+        std::println("Could not load scene: {}", file.error());
+        return Scene(nullptr);
+    }
+    // Baked scenes may keep the path of their source, so sniff the format
+    if (BakedScene::IsBaked(file->GetData())) {
+        auto baked = BakedScene::Open(std::move(file.value()));
+        if (!baked) {
+            std::println("Could not load baked scene {}: {}", p_id, baked.error());
+            return Scene(nullptr);
+        }
+        return Scene(std::move(baked.value()));
+    }
+    return Scene(std::make_shared<YAML::Node>(YAML::Load(std::string(file->Data(), file->Size()))));
 }
 
-void Unload() {
+void Scene::Unload() {
+}
+
+Result<Scene> Scene::Prepare(StringID p_id) {
+    auto file = FileSystem::Map(p_id);
+    CHECK_RET(file);
+    if (BakedScene::IsBaked(file->GetData())) {
+        auto baked = BakedScene::Open(std::move(file.value()));
+        CHECK_RET(baked);
+        return Scene(std::move(baked.value()));
+    }
+    // The prototype is built right away to keep the work off the render thread
+    auto prototype = BakePrototype(YAML::Load(std::string(file->Data(), file->Size())));
+    CHECK_RET(prototype);
+    return Scene(std::move(prototype.value()));
 }
\ No newline at end of file
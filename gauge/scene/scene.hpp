@@ -1,6 +1,9 @@
 #pragma once
 
 #include <gauge/common.hpp>
+#include <gauge/scene/baked_scene.hpp>
+
+#include <optional>
 
 namespace YAML {
 class Node;
@@ -14,16 +17,24 @@ class StringID;
 class Scene {
    private:
     Ref<YAML::Node> state;
+    std::optional<BakedScene> baked;
 
    public:
     Ref<Node> FromData(YAML::Node p_data);
     Ref<Node> Instantiate();
+    // Scenes loaded with LoadAsync are always baked, see Prepare
+    const BakedScene* GetBaked() const { return baked ? &baked.value() : nullptr; }
 
     Scene(Ref<YAML::Node> p_state = nullptr) : state(p_state) {}
+    Scene(BakedScene p_baked) : baked(std::move(p_baked)) {}
 
     // --- Resource interface ---
     static Scene Load(StringID p_id);
     void Unload();
+
+    // Reads and bakes the scene on a worker thread, see ResourceManager::LoadAsync
+    static Result<Scene> Prepare(StringID p_id);
+    Result<> Upload() { return {}; }
 };
 
 }  // namespace Gauge
\ No newline at end of file
@@ -0,0 +1,201 @@
+#include "scene_baker.hpp"
+
+#include <gauge/core/string_id.hpp>
+#include <gauge/scene/property_blob.hpp>
+
+#include <yaml-cpp/yaml.h>
+
+#include <cstring>
+#include <format>
+
+using namespace Gauge;
+
+namespace {
+
+constexpr size_t TABLE_ALIGNMENT = 16;
+// PropertyBlobs are read in place and contain 8 byte fields
+constexpr size_t BLOB_ALIGNMENT = 8;
+
+// YAML 1.2 booleans only. yaml-cpp also decodes y/n/yes/no/on/off, which
+// stay strings here so names like "on" or "no" are not baked as bools.
+bool DecodeBool(const YAML::Node& p_value, bool& r_value) {
+    const std::string& scalar = p_value.Scalar();
+    if (scalar == "true" || scalar == "True" || scalar == "TRUE") {
+        r_value = true;
+        return true;
+    }
+    if (scalar == "false" || scalar == "False" || scalar == "FALSE") {
+        r_value = false;
+        return true;
+    }
+    return false;
+}
+
+template <typename T>
+uint64_t AppendTable(std::vector<char>& r_output, const std::vector<T>& p_table) {
+    r_output.resize((r_output.size() + TABLE_ALIGNMENT - 1) / TABLE_ALIGNMENT * TABLE_ALIGNMENT);
+    const uint64_t offset = r_output.size();
+    const char* bytes = reinterpret_cast<const char*>(p_table.data());
+    r_output.insert(r_output.end(), bytes, bytes + p_table.size() * sizeof(T));
+    return offset;
+}
+
+}  // namespace
+
+Result<uint64_t> SceneBaker::Intern(const std::string& p_string) {
+    const uint64_t id = StringID::Hash(p_string);
+    auto [it, inserted] = interned.try_emplace(id, p_string);
+    if (!inserted) {
+        if (it->second != p_string) {
+            return Error(std::format("Hash collision between '{}' and '{}'", p_string, it->second));
+        }
+        return id;
+    }
+    strings.push_back(BakedScene::StringEntry{
+        .id = id,
+        .offset = AppendData(p_string, 1),
+        .length = uint32_t(p_string.size()),
+    });
+    return id;
+}
+
+uint32_t SceneBaker::AppendData(std::string_view p_bytes, size_t p_alignment) {
+    data.resize((data.size() + p_alignment - 1) / p_alignment * p_alignment);
+    const uint32_t offset = data.size();
+    data.insert(data.end(), p_bytes.begin(), p_bytes.end());
+    return offset;
+}
+
+std::optional<std::vector<char>> SceneBaker::BakeProperties(const YAML::Node& p_component) {
+    PropertyBlobWriter writer;
+    for (const auto& property : p_component) {
+        const std::string key = property.first.as<std::string>();
+        const YAML::Node& value = property.second;
+        if (key == "type") {
+            continue;
+        }
+
+        if (value.IsScalar()) {
+            bool bool_value;
+            int64_t int_value;
+            double float_value;
+            // Quoted scalars are always strings
+            if (value.Tag() == "!") {
+                writer.AddString(key, value.Scalar());
+            } else if (DecodeBool(value, bool_value)) {
+                writer.AddBool(key, bool_value);
+            } else if (YAML::convert<int64_t>::decode(value, int_value)) {
+                writer.AddInt(key, int_value);
+            } else if (YAML::convert<double>::decode(value, float_value)) {
+                const float element = float_value;
+                writer.AddFloats(key, {&element, 1});
+            } else {
+                writer.AddString(key, value.Scalar());
+            }
+        } else if (value.IsSequence()) {
+            std::vector<float> elements;
+            for (const YAML::Node& element : value) {
+                double element_value;
+                if (!element.IsScalar() || element.Tag() == "!" || !YAML::convert<double>::decode(element, element_value)) {
+                    return std::nullopt;
+                }
+                elements.push_back(element_value);
+            }
+            writer.AddFloats(key, elements);
+        } else {
+            return std::nullopt;
+        }
+    }
+    return writer.Finish();
+}
+
+Result<> SceneBaker::BakeComponent(const YAML::Node& p_component) {
+    if (!p_component["type"]) {
+        return Error("Component without type");
+    }
+    auto type = Intern(p_component["type"].as<std::string>());
+    CHECK_RET(type);
+
+    for (const auto& property : p_component) {
+        auto key = Intern(property.first.as<std::string>());
+        CHECK_RET(key);
+    }
+
+    BakedScene::ComponentEntry entry{.type = type.value()};
+    if (auto blob = BakeProperties(p_component)) {
+        entry.encoding = BakedScene::Encoding::PROPERTIES;
+        entry.offset = AppendData({blob->data(), blob->size()}, BLOB_ALIGNMENT);
+        entry.size = blob->size();
+    } else {
+        YAML::Emitter emitter;
+        emitter << p_component;
+        entry.encoding = BakedScene::Encoding::YAML;
+        entry.offset = AppendData(emitter.c_str(), 1);
+        entry.size = emitter.size();
+    }
+    components.push_back(entry);
+    return {};
+}
+
+Result<> SceneBaker::BakeNode(const YAML::Node& p_node, uint32_t p_parent) {
+    const uint32_t index = nodes.size();
+    BakedScene::NodeEntry entry{
+        .parent = p_parent,
+        .first_component = uint32_t(components.size()),
+    };
+
+    // Like Scene::FromData, subscene references ignore everything else
+    if (p_parent != BakedScene::INVALID_INDEX && p_node["scene"]) {
+        auto scene = Intern(p_node["scene"].as<std::string>());
+        CHECK_RET(scene);
+        entry.scene = scene.value();
+        nodes.push_back(entry);
+        return {};
+    }
+
+    auto name = Intern(p_node["name"] ? p_node["name"].as<std::string>() : "[Node]");
+    CHECK_RET(name);
+    entry.name = name.value();
+    if (p_node["position"]) {
+        for (uint i = 0; i < 3; ++i) {
+            entry.position[i] = p_node["position"][i].as<float>();
+        }
+        entry.flags |= BakedScene::HAS_POSITION;
+    }
+    if (p_node["scale"]) {
+        entry.scale = p_node["scale"].as<float>();
+        entry.flags |= BakedScene::HAS_SCALE;
+    }
+
+    for (const YAML::Node& component : p_node["components"]) {
+        auto baked = BakeComponent(component);
+        CHECK_RET(baked);
+        entry.component_count++;
+    }
+    nodes.push_back(entry);
+
+    for (const YAML::Node& child : p_node["children"]) {
+        auto baked = BakeNode(child, index);
+        CHECK_RET(baked);
+    }
+    return {};
+}
+
+std::vector<char> SceneBaker::Finish() const {
+    std::vector<char> output(sizeof(BakedScene::Header));
+
+    BakedScene::Header header{};
+    std::memcpy(header.magic, BakedScene::MAGIC, sizeof(header.magic));
+    header.version = BakedScene::VERSION;
+    header.node_count = nodes.size();
+    header.component_count = components.size();
+    header.string_count = strings.size();
+    header.nodes_offset = AppendTable(output, nodes);
+    header.components_offset = AppendTable(output, components);
+    header.strings_offset = AppendTable(output, strings);
+    header.data_offset = AppendTable(output, data);
+    header.data_size = data.size();
+
+    std::memcpy(output.data(), &header, sizeof(header));
+    return output;
+}
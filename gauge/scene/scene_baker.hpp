@@ -0,0 +1,45 @@
+#pragma once
+
+#include <gauge/common.hpp>
+#include <gauge/scene/baked_scene.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace YAML {
+class Node;
+}
+
+namespace Gauge {
+
+// Turns a YAML scene into the BakedScene format. Used offline by
+// gauge_bake_scene and at runtime to build the prototype of a YAML scene.
+class SceneBaker {
+    std::vector<BakedScene::NodeEntry> nodes;
+    std::vector<BakedScene::ComponentEntry> components;
+    std::vector<BakedScene::StringEntry> strings;
+    std::unordered_map<uint64_t, std::string> interned;
+    std::vector<char> data;
+
+    Result<uint64_t> Intern(const std::string& p_string);
+    uint32_t AppendData(std::string_view p_bytes, size_t p_alignment);
+
+    // Empty if the parameters have to stay YAML
+    std::optional<std::vector<char>> BakeProperties(const YAML::Node& p_component);
+    Result<> BakeComponent(const YAML::Node& p_component);
+    Result<> BakeNode(const YAML::Node& p_node, uint32_t p_parent);
+
+   public:
+    Result<> Bake(const YAML::Node& p_root) { return BakeNode(p_root, BakedScene::INVALID_INDEX); }
+
+    // Contents of the baked file
+    std::vector<char> Finish() const;
+
+    uint GetNodeCount() const { return nodes.size(); }
+    uint GetComponentCount() const { return components.size(); }
+};
+
+}  // namespace Gauge
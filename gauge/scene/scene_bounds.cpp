@@ -0,0 +1,121 @@
+#include "scene_bounds.hpp"
+
+#include <gauge/math/batch.hpp>
+#include <gauge/scene/node.hpp>
+#include <gauge/scene/transform_hierarchy.hpp>
+
+using namespace Gauge;
+
+SceneBounds& SceneBounds::Get() {
+    // Never destroyed, nodes may be destroyed during static destruction
+    static SceneBounds* bounds = new SceneBounds();
+    return *bounds;
+}
+
+void SceneBounds::Add(Node& p_node) {
+    const uint id = p_node.transform_id;
+    if (id >= entries.size()) {
+        entries.resize(id + 1);
+    }
+    if (entries[id].node != nullptr) {
+        return;
+    }
+    // Bounds are usually assigned after the components are added
+    entries[id].node = &p_node;
+    pending.push_back(id);
+}
+
+void SceneBounds::Remove(uint p_transform_id) {
+    if (p_transform_id >= entries.size() || entries[p_transform_id].node == nullptr) {
+        return;
+    }
+    Entry& entry = entries[p_transform_id];
+    if (entry.proxy != BVH::INVALID_PROXY) {
+        bvh.Remove(entry.proxy);
+    }
+    entry = Entry{};
+}
+
+void SceneBounds::Update() {
+    const TransformHierarchy& hierarchy = TransformHierarchy::Get();
+    update_ids.clear();
+    update_transforms.clear();
+    update_bounds.clear();
+    auto refresh = [&](uint p_id) {
+        update_ids.push_back(p_id);
+        update_transforms.push_back(hierarchy.GetGlobal(p_id));
+        update_bounds.push_back(entries[p_id].node->aabb);
+    };
+
+    // Ids may have been removed or even reused since they were added. Added
+    // nodes are not in the tree yet, so none is refreshed twice.
+    for (uint id : pending) {
+        const Entry& entry = entries[id];
+        if (entry.node != nullptr && entry.proxy == BVH::INVALID_PROXY && entry.node->aabb.IsValid()) {
+            refresh(id);
+        }
+    }
+    pending.clear();
+    for (uint id : hierarchy.GetChanged()) {
+        if (id < entries.size() && entries[id].proxy != BVH::INVALID_PROXY) {
+            refresh(id);
+        }
+    }
+
+    Math::TransformAABBs(update_transforms, update_bounds, update_bounds);
+    for (uint i = 0; i < update_ids.size(); ++i) {
+        Entry& entry = entries[update_ids[i]];
+        entry.bounds = update_bounds[i];
+        if (entry.proxy == BVH::INVALID_PROXY) {
+            entry.proxy = bvh.Insert(entry.bounds, update_ids[i]);
+        } else {
+            bvh.Move(entry.proxy, entry.bounds);
+        }
+    }
+}
+
+void SceneBounds::BeginCulling(const Frustum& p_frustum, CullingStats& r_stats) {
+    culling_pass++;
+    culling_stats = &r_stats;
+    *culling_stats = CullingStats{};
+    bvh.QueryFrustum(p_frustum, [&](uint p_id) {
+        if (p_frustum.IsVisible(entries[p_id].bounds)) {
+            entries[p_id].visible_pass = culling_pass;
+        }
+    });
+}
+
+void SceneBounds::EndCulling() {
+    culling_stats = nullptr;
+}
+
+bool SceneBounds::PassesCulling(uint p_transform_id) {
+    if (culling_stats == nullptr) {
+        return true;
+    }
+    culling_stats->tested++;
+    if (p_transform_id < entries.size() && entries[p_transform_id].proxy != BVH::INVALID_PROXY &&
+        entries[p_transform_id].visible_pass != culling_pass) {
+        culling_stats->culled++;
+        return false;
+    }
+    culling_stats->drawn++;
+    return true;
+}
+
+Node* SceneBounds::Raycast(Vec3 p_origin, Vec3 p_direction, float p_max_distance, float* r_distance) const {
+    const Vec3 inverse_direction = 1.0f / glm::vec3(p_direction);
+    Node* closest = nullptr;
+    bvh.Raycast(p_origin, p_direction, p_max_distance, [&](uint p_id, float p_distance) {
+        float distance;
+        if (!entries[p_id].bounds.IntersectsRay(p_origin, inverse_direction, p_distance, distance)) {
+            return p_distance;
+        }
+        closest = entries[p_id].node;
+        if (r_distance != nullptr) {
+            *r_distance = distance;
+        }
+        return distance;
+    });
+    return closest;
+}
\ No newline at end of file
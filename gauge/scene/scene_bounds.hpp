@@ -0,0 +1,110 @@
+#pragma once
+
+#include <gauge/common.hpp>
+#include <gauge/math/common.hpp>
+#include <gauge/math/transform.hpp>
+#include <gauge/renderer/aabb.hpp>
+#include <gauge/renderer/bvh.hpp>
+#include <gauge/renderer/frustum.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace Gauge {
+
+class Node;
+
+// World space bounds of the nodes that have something to draw, kept in a BVH
+// for culling and picking on the CPU. Nodes are added by their MeshInstance
+// and removed when destroyed. Update reads the bounds of added nodes and moves
+// those whose global transform changed, so it runs right after the
+// TransformHierarchy update.
+//
+// Adding and removing nodes follows the rules of the TransformHierarchy.
+class SceneBounds {
+   public:
+    // Objects that asked whether they pass culling, and how many of them
+    // were outside the frustum or went on to be drawn
+    struct CullingStats {
+        uint tested = 0;
+        uint culled = 0;
+        uint drawn = 0;
+    };
+
+   private:
+    struct Entry {
+        Node* node = nullptr;
+        uint proxy = BVH::INVALID_PROXY;
+        // Exact world bounds, the BVH only stores enlarged ones
+        AABB bounds;
+        // Last culling pass that found the node inside the frustum
+        uint visible_pass = 0;
+    };
+
+    // Indexed by transform id
+    std::vector<Entry> entries;
+    // Transform ids added since the last update
+    std::vector<uint> pending;
+    BVH bvh;
+
+    uint culling_pass = 0;
+    CullingStats* culling_stats = nullptr;
+
+    // Scratch space of Update, kept to reuse the allocations
+    std::vector<uint> update_ids;
+    std::vector<Transform> update_transforms;
+    std::vector<AABB> update_bounds;
+
+   public:
+    void Add(Node& p_node);
+    void Remove(uint p_transform_id);
+    void Update();
+
+    const BVH& GetBVH() const { return bvh; }
+
+    // Marks the nodes inside the frustum for PassesCulling until EndCulling
+    void BeginCulling(const Frustum& p_frustum, CullingStats& r_stats);
+    void EndCulling();
+    // Whether the node was inside the frustum of the current culling pass,
+    // counted in its stats. Nodes without bounds are never culled, neither
+    // is anything outside of a pass.
+    bool PassesCulling(uint p_transform_id);
+
+    // p_callback(Node*) for every node whose bounds overlap the box
+    template <typename F>
+    void Query(const AABB& p_aabb, F&& p_callback) const {
+        bvh.Query(p_aabb, [&](uint p_id) {
+            if (entries[p_id].bounds.Intersects(p_aabb)) {
+                p_callback(entries[p_id].node);
+            }
+        });
+    }
+
+    // p_callback(Node*) for every node whose bounds overlap the sphere
+    template <typename F>
+    void QuerySphere(Vec3 p_center, float p_radius, F&& p_callback) const {
+        bvh.QuerySphere(p_center, p_radius, [&](uint p_id) {
+            if (entries[p_id].bounds.IntersectsSphere(p_center, p_radius)) {
+                p_callback(entries[p_id].node);
+            }
+        });
+    }
+
+    // p_callback(Node*) for every node whose bounds are at least partially
+    // inside the frustum
+    template <typename F>
+    void QueryFrustum(const Frustum& p_frustum, F&& p_callback) const {
+        bvh.QueryFrustum(p_frustum, [&](uint p_id) {
+            if (p_frustum.IsVisible(entries[p_id].bounds)) {
+                p_callback(entries[p_id].node);
+            }
+        });
+    }
+
+    // Node with the closest bounds along the ray, regardless of visibility
+    Node* Raycast(Vec3 p_origin, Vec3 p_direction, float p_max_distance = std::numeric_limits<float>::max(), float* r_distance = nullptr) const;
+
+    static SceneBounds& Get();
+};
+
+}  // namespace Gauge
\ No newline at end of file
@@ -3,6 +3,11 @@
 using namespace Gauge;
 
 void SceneTree::Draw() {
+    // Contiguously stored components are drawn type by type, the tree walk
+    // only covers the rest
+    for (ComponentStorageBase* storage : ComponentStorageBase::GetAll()) {
+        storage->Draw(*root);
+    }
     root->Draw();
 }
 
@@ -0,0 +1,238 @@
+#include "transform_hierarchy.hpp"
+
+#include <gauge/math/batch.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+using namespace Gauge;
+
+TransformHierarchy& TransformHierarchy::Get() {
+    static TransformHierarchy hierarchy;
+    return hierarchy;
+}
+
+uint TransformHierarchy::Create() {
+    uint id;
+    if (free_head != INVALID_ID) {
+        id = free_head;
+        free_head = sparse[id];
+    } else {
+        id = sparse.size();
+        sparse.emplace_back();
+    }
+
+    // Roots can go anywhere, appending keeps parents ahead of children
+    sparse[id] = ids.size();
+    local_transforms.emplace_back();
+    global_transforms.emplace_back();
+    parents.push_back(INVALID_INDEX);
+    ids.push_back(id);
+    dirty.push_back(0);
+    return id;
+}
+
+void TransformHierarchy::Destroy(uint p_id) {
+    const uint index = sparse[p_id];
+    ids[index] = INVALID_ID;
+    dead_count++;
+    unsorted = true;
+
+    sparse[p_id] = free_head;
+    free_head = p_id;
+}
+
+void TransformHierarchy::SetParent(uint p_id, uint p_parent) {
+    const uint index = sparse[p_id];
+    const uint parent_index = p_parent == INVALID_ID ? INVALID_INDEX : sparse[p_parent];
+    assert(parent_index != index);
+    parents[index] = parent_index;
+    if (parent_index != INVALID_INDEX && parent_index > index) {
+        unsorted = true;
+    }
+    MarkDirty(index);
+}
+
+void TransformHierarchy::SetLocal(uint p_id, const Transform& p_transform) {
+    const uint index = sparse[p_id];
+    local_transforms[index] = p_transform;
+    MarkDirty(index);
+}
+
+void TransformHierarchy::MarkDirty(uint p_index) {
+    if (!dirty[p_index]) {
+        dirty[p_index] = 1;
+        dirty_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    uint first = first_dirty.load(std::memory_order_relaxed);
+    while (p_index < first && !first_dirty.compare_exchange_weak(first, p_index, std::memory_order_relaxed)) {
+    }
+}
+
+Transform TransformHierarchy::GetGlobal(uint p_id) const {
+    const uint index = sparse[p_id];
+    if (dirty_count.load(std::memory_order_relaxed) == 0) {
+        return global_transforms[index];
+    }
+
+    // Only the part of the chain below the topmost flagged ancestor is stale
+    uint top = INVALID_INDEX;
+    for (uint i = index; i != INVALID_INDEX; i = parents[i]) {
+        if (dirty[i]) {
+            top = i;
+        }
+    }
+    if (top == INVALID_INDEX) {
+        return global_transforms[index];
+    }
+
+    Transform result = local_transforms[index];
+    uint i = parents[index];
+    for (; i != parents[top]; i = parents[i]) {
+        result = local_transforms[i] * result;
+    }
+    if (i != INVALID_INDEX) {
+        result = global_transforms[i] * result;
+    }
+    return result;
+}
+
+void TransformHierarchy::Sort() {
+    const uint count = ids.size();
+
+    // Orphans of removed nodes become roots, like their weak parent pointers
+    std::vector<uint> depths(count, INVALID_INDEX);
+    uint max_depth = 0;
+    for (uint index = 0; index < count; ++index) {
+        if (ids[index] == INVALID_ID) {
+            continue;
+        }
+        if (parents[index] != INVALID_INDEX && ids[parents[index]] == INVALID_ID) {
+            parents[index] = INVALID_INDEX;
+            dirty[index] = 1;
+        }
+
+        // Walk up to the first ancestor with a known depth, then assign
+        // depths on the way back down
+        uint length = 0;
+        uint i = index;
+        while (depths[i] == INVALID_INDEX && parents[i] != INVALID_INDEX && ids[parents[i]] != INVALID_ID) {
+            i = parents[i];
+            length++;
+        }
+        uint depth = depths[i] != INVALID_INDEX ? depths[i] : 0;
+        depths[i] = depth;
+        const uint top = i;
+        depth += length;
+        for (i = index; i != top; i = parents[i]) {
+            depths[i] = depth--;
+        }
+        max_depth = std::max(max_depth, depths[index]);
+    }
+
+    // Counting sort by depth, keeping the existing order within a level
+    std::vector<uint> offsets(max_depth + 2, 0);
+    for (uint index = 0; index < count; ++index) {
+        if (ids[index] != INVALID_ID) {
+            offsets[depths[index] + 1]++;
+        }
+    }
+    for (uint depth = 1; depth < offsets.size(); ++depth) {
+        offsets[depth] += offsets[depth - 1];
+    }
+    std::vector<uint> remap(count, INVALID_INDEX);
+    for (uint index = 0; index < count; ++index) {
+        if (ids[index] != INVALID_ID) {
+            remap[index] = offsets[depths[index]]++;
+        }
+    }
+
+    const uint live_count = count - dead_count;
+    std::vector<Transform> sorted_local(live_count);
+    std::vector<Transform> sorted_global(live_count);
+    std::vector<uint> sorted_parents(live_count);
+    std::vector<uint> sorted_ids(live_count);
+    std::vector<uint8_t> sorted_dirty(live_count);
+    uint sorted_dirty_count = 0;
+    uint sorted_first_dirty = INVALID_INDEX;
+    for (uint index = 0; index < count; ++index) {
+        const uint target = remap[index];
+        if (target == INVALID_INDEX) {
+            continue;
+        }
+        sorted_local[target] = local_transforms[index];
+        sorted_global[target] = global_transforms[index];
+        sorted_parents[target] = parents[index] == INVALID_INDEX ? INVALID_INDEX : remap[parents[index]];
+        sorted_ids[target] = ids[index];
+        sorted_dirty[target] = dirty[index];
+        sparse[ids[index]] = target;
+        if (dirty[index]) {
+            sorted_dirty_count++;
+            sorted_first_dirty = std::min(sorted_first_dirty, target);
+        }
+    }
+
+    local_transforms = std::move(sorted_local);
+    global_transforms = std::move(sorted_global);
+    parents = std::move(sorted_parents);
+    ids = std::move(sorted_ids);
+    dirty = std::move(sorted_dirty);
+    dirty_count = sorted_dirty_count;
+    first_dirty = sorted_first_dirty;
+    dead_count = 0;
+    unsorted = false;
+}
+
+void TransformHierarchy::Update() {
+    changed.clear();
+    if (unsorted) {
+        Sort();
+    }
+    if (dirty_count == 0) {
+        return;
+    }
+
+    // Parents precede children, so a single pass sees every changed parent
+    // before its children. The flag is set on recomputed nodes to pass the
+    // change down.
+    const uint count = ids.size();
+    const uint first = first_dirty;
+    compose_indices.clear();
+    for (uint index = first; index < count; ++index) {
+        const uint parent = parents[index];
+        if (parent == INVALID_INDEX) {
+            if (dirty[index]) {
+                global_transforms[index] = local_transforms[index];
+                changed.push_back(ids[index]);
+            }
+        } else if (dirty[index] || dirty[parent]) {
+            dirty[index] = 1;
+            compose_indices.push_back(index);
+            changed.push_back(ids[index]);
+        }
+    }
+
+    // Composed in batches whose parents are all final. A batch ends at the
+    // first node whose parent might be part of it, with the arrays sorted by
+    // depth that is roughly one batch per level.
+    for (uint begin = 0; begin < compose_indices.size();) {
+        const uint batch_start = compose_indices[begin];
+        compose_parents.clear();
+        compose_locals.clear();
+        uint end = begin;
+        for (; end < compose_indices.size() && parents[compose_indices[end]] < batch_start; ++end) {
+            compose_parents.push_back(global_transforms[parents[compose_indices[end]]]);
+            compose_locals.push_back(local_transforms[compose_indices[end]]);
+        }
+        Math::ComposeTransforms(compose_parents, compose_locals, compose_locals);
+        for (uint i = begin; i < end; ++i) {
+            global_transforms[compose_indices[i]] = compose_locals[i - begin];
+        }
+        begin = end;
+    }
+
+    std::memset(dirty.data() + first, 0, count - first);
+    dirty_count = 0;
+    first_dirty = INVALID_INDEX;
+}
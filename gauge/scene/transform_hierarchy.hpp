@@ -0,0 +1,79 @@
+#pragma once
+
+#include <gauge/math/transform.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace Gauge {
+
+// Local and global transforms of all nodes, stored as parallel arrays sorted
+// by depth so that parents always precede their children. Setting a local
+// transform only flags the node; Update then walks the arrays once, starting
+// at the first flagged entry, and recomputes exactly the flagged nodes and
+// their descendants.
+//
+// Nodes refer to their entry by a stable id. Entries are addressed through
+// an indirection because reparenting and removal reorder the arrays.
+//
+// SetLocal may be called concurrently for different nodes. Creating,
+// destroying and reparenting nodes must not overlap with any other call.
+class TransformHierarchy {
+   public:
+    static constexpr uint INVALID_ID = ~0u;
+
+   private:
+    static constexpr uint INVALID_INDEX = ~0u;
+
+    // Id -> position in the arrays for live ids, next free id otherwise
+    std::vector<uint> sparse;
+    uint free_head = INVALID_ID;
+
+    std::vector<Transform> local_transforms;
+    std::vector<Transform> global_transforms;
+    std::vector<uint> parents;
+    std::vector<uint> ids;
+    // Local transform or parent changed since the last update
+    std::vector<uint8_t> dirty;
+    // Ids whose global transform the last update recomputed
+    std::vector<uint> changed;
+    // Scratch space of Update, kept to reuse the allocations
+    std::vector<uint> compose_indices;
+    std::vector<Transform> compose_parents;
+    std::vector<Transform> compose_locals;
+
+    std::atomic<uint> dirty_count = 0;
+    std::atomic<uint> first_dirty = INVALID_INDEX;
+    // Entries were added, removed or reparented and are no longer sorted
+    bool unsorted = false;
+    uint dead_count = 0;
+
+    void MarkDirty(uint p_index);
+    void Sort();
+
+   public:
+    uint Create();
+    void Destroy(uint p_id);
+
+    // p_parent may be INVALID_ID to make the node a root
+    void SetParent(uint p_id, uint p_parent);
+
+    const Transform& GetLocal(uint p_id) const { return local_transforms[sparse[p_id]]; }
+    void SetLocal(uint p_id, const Transform& p_transform);
+    // Up to date even before the next Update, in which case the transform
+    // is composed from the ancestors without writing back
+    Transform GetGlobal(uint p_id) const;
+
+    // Recomputes the global transforms of flagged nodes and their subtrees
+    void Update();
+
+    uint Count() const { return ids.size() - dead_count; }
+    uint GetDirtyCount() const { return dirty_count; }
+    const std::vector<uint>& GetChanged() const { return changed; }
+
+    // Hierarchy shared by all nodes
+    static TransformHierarchy& Get();
+};
+
+}  // namespace Gauge
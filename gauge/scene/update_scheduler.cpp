@@ -0,0 +1,133 @@
+#include "update_scheduler.hpp"
+
+#include <gauge/components/component.hpp>
+#include <gauge/core/job_system.hpp>
+#include <gauge/scene/node.hpp>
+
+#include <algorithm>
+
+using namespace Gauge;
+
+namespace {
+
+void UpdateRange(const std::vector<Component*>& p_components, uint p_begin, uint p_end, float p_delta) {
+    for (uint i = p_begin; i < p_end; ++i) {
+        p_components[i]->Update(p_delta);
+    }
+}
+
+}  // namespace
+
+UpdateScheduler& UpdateScheduler::Get() {
+    static UpdateScheduler scheduler;
+    return scheduler;
+}
+
+bool UpdateScheduler::Conflicts(uint p_access_a, uint p_access_b) {
+    constexpr uint EXCLUSIVE_BIT = UpdateAccess::EXCLUSIVE & ~UpdateAccess::MAIN_THREAD;
+    constexpr uint TRANSFORM = UpdateAccess::TRANSFORM_READ | UpdateAccess::TRANSFORM_WRITE;
+
+    if ((p_access_a | p_access_b) & EXCLUSIVE_BIT) {
+        return true;
+    }
+    if ((p_access_a & UpdateAccess::TRANSFORM_WRITE) && (p_access_b & TRANSFORM)) {
+        return true;
+    }
+    if ((p_access_b & UpdateAccess::TRANSFORM_WRITE) && (p_access_a & TRANSFORM)) {
+        return true;
+    }
+    return (p_access_a & UpdateAccess::PHYSICS) && (p_access_b & UpdateAccess::PHYSICS);
+}
+
+bool UpdateScheduler::IsParallel(uint p_access) {
+    if (p_access & (UpdateAccess::MAIN_THREAD | UpdateAccess::PHYSICS)) {
+        return false;
+    }
+    // An instance could read the transform of a node another one is writing
+    return !((p_access & UpdateAccess::TRANSFORM_READ) && (p_access & UpdateAccess::TRANSFORM_WRITE));
+}
+
+void UpdateScheduler::Collect(Node& p_node) {
+    if (!p_node.active) {
+        return;
+    }
+    for (const auto& component : p_node.GetComponents()) {
+        if (!component->active) {
+            continue;
+        }
+
+        auto it = batch_indices.find(component->type);
+        if (it == batch_indices.end()) {
+            it = batch_indices.emplace(component->type, batches.size()).first;
+            batches.push_back(Batch{.access = component->GetUpdateAccess()});
+        }
+
+        Batch& batch = batches[it->second];
+        if (batch.run != run) {
+            batch.run = run;
+            batch.components.clear();
+            order.push_back(it->second);
+        }
+        batch.components.push_back(component.get());
+    }
+    for (const auto& child : p_node.children) {
+        Collect(*child);
+    }
+}
+
+void UpdateScheduler::RunStage(uint p_begin, uint p_end, float p_delta) {
+    JobSystem& job_system = JobSystem::Get();
+    JobCounter counter;
+
+    ranges.clear();
+    for (uint i = p_begin; i < p_end; ++i) {
+        const Batch& batch = batches[order[i]];
+        const uint count = batch.components.size();
+        if (IsParallel(batch.access)) {
+            for (uint begin = 0; begin < count; begin += BATCH_SIZE) {
+                ranges.push_back(Range{&batch, begin, std::min(begin + BATCH_SIZE, count)});
+            }
+        } else if (!(batch.access & UpdateAccess::MAIN_THREAD)) {
+            ranges.push_back(Range{&batch, 0, count});
+        }
+    }
+
+    // Ranges must not move anymore once jobs are running
+    delta = p_delta;
+    for (uint i = 0; i < ranges.size(); ++i) {
+        job_system.Submit(
+            [this, i]() {
+                const Range& range = ranges[i];
+                UpdateRange(range.batch->components, range.begin, range.end, delta);
+            },
+            &counter);
+    }
+
+    // Main thread types run here while the workers take care of the rest
+    for (uint i = p_begin; i < p_end; ++i) {
+        const Batch& batch = batches[order[i]];
+        if (batch.access & UpdateAccess::MAIN_THREAD) {
+            UpdateRange(batch.components, 0, batch.components.size(), p_delta);
+        }
+    }
+
+    job_system.Wait(counter);
+}
+
+void UpdateScheduler::Run(Node& p_root, float p_delta) {
+    run++;
+    order.clear();
+    Collect(p_root);
+
+    uint stage_begin = 0;
+    while (stage_begin < order.size()) {
+        uint stage_access = batches[order[stage_begin]].access;
+        uint stage_end = stage_begin + 1;
+        while (stage_end < order.size() && !Conflicts(stage_access, batches[order[stage_end]].access)) {
+            stage_access |= batches[order[stage_end]].access;
+            stage_end++;
+        }
+        RunStage(stage_begin, stage_end, p_delta);
+        stage_begin = stage_end;
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <gauge/common.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace Gauge {
+
+class Node;
+struct Component;
+
+// Runs the update phase of a scene tree. Active components are gathered
+// per type in depth-first order, then split into stages: consecutive types
+// join the current stage as long as their UpdateAccess does not conflict
+// with it. Types within a stage run concurrently on the job system and
+// stages run one after another, so conflicting types always update in the
+// order they first appear in the tree. Instances of a type are updated in
+// parallel unless their access requires them to run one at a time, in which
+// case they keep the tree order.
+class UpdateScheduler {
+    struct Batch {
+        uint access;
+        std::vector<Component*> components;
+        uint64_t run;
+    };
+
+    // Keyed by Component::type
+    std::unordered_map<const void*, uint> batch_indices;
+    std::vector<Batch> batches;
+    // Batches used in the current run, in order of first appearance
+    std::vector<uint> order;
+    uint64_t run = 0;
+
+    // Components a job of the current stage updates. Jobs only capture an
+    // index into this, which std::function stores without allocating, and
+    // the vector keeps its capacity between runs.
+    struct Range {
+        const Batch* batch;
+        uint begin;
+        uint end;
+    };
+    std::vector<Range> ranges;
+    float delta = 0.0f;
+
+    void Collect(Node& p_node);
+    void RunStage(uint p_begin, uint p_end, float p_delta);
+
+   public:
+    // Components of parallel types per job
+    static constexpr uint BATCH_SIZE = 32;
+
+    static bool Conflicts(uint p_access_a, uint p_access_b);
+    static bool IsParallel(uint p_access);
+
+    void Run(Node& p_root, float p_delta);
+
+    // Scheduler used by Node::Update
+    static UpdateScheduler& Get();
+};
+
+}  // namespace Gauge
@@ -0,0 +1,206 @@
+#include "world_streamer.hpp"
+
+#include <gauge/components/streamed_scene.hpp>
+#include <gauge/core/resource_manager.hpp>
+#include <gauge/renderer/aabb.hpp>
+#include <gauge/scene/node.hpp>
+#include <gauge/scene/scene.hpp>
+
+#include <algorithm>
+#include <print>
+
+using namespace Gauge;
+
+WorldStreamer& WorldStreamer::Get() {
+    // Never destroyed, components may unregister during static destruction
+    static WorldStreamer* streamer = new WorldStreamer();
+    return *streamer;
+}
+
+void WorldStreamer::Register(StreamedScene* p_volume) {
+    volumes.push_back(p_volume);
+}
+
+void WorldStreamer::Unregister(StreamedScene* p_volume) {
+    auto it = std::ranges::find(volumes, p_volume);
+    if (it == volumes.end()) {
+        return;
+    }
+    *it = volumes.back();
+    volumes.pop_back();
+    Release(*p_volume);
+}
+
+float WorldStreamer::GetDistance(const StreamedScene& p_volume, Vec3 p_viewer) {
+    const AABB bounds = p_volume.node->GetGlobalTransform() * p_volume.bounds;
+    const glm::vec3 closest = glm::clamp(glm::vec3(p_viewer), glm::vec3(bounds.min), glm::vec3(bounds.max));
+    return glm::distance(closest, glm::vec3(p_viewer));
+}
+
+bool WorldStreamer::IsLoaded(const Node& p_node) {
+    for (const auto& component : p_node.GetComponents()) {
+        if (!component->IsLoaded()) {
+            return false;
+        }
+    }
+    for (const auto& child : p_node.children) {
+        if (!IsLoaded(*child)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool WorldStreamer::IsReleased(const Node& p_node) {
+    Ref<Node> root = p_node.parent.lock();
+    if (root == nullptr) {
+        return !p_node.active;
+    }
+    while (Ref<Node> parent = root->parent.lock()) {
+        root = std::move(parent);
+    }
+    return !root->active;
+}
+
+void WorldStreamer::Release(StreamedScene& r_volume) {
+    using State = StreamedScene::State;
+    if (r_volume.state == State::ATTACHED && r_volume.node != nullptr) {
+        r_volume.node->RemoveChild(r_volume.instance);
+    }
+    if (r_volume.instancer.has_value()) {
+        r_volume.instance = r_volume.instancer->GetRoot();
+        r_volume.instancer.reset();
+    }
+    if (r_volume.instance != nullptr) {
+        r_volume.instance->active = false;
+        released.push_back(std::move(r_volume.instance));
+    }
+    if (r_volume.state == State::LOADING || r_volume.state == State::INSTANTIATING ||
+        r_volume.state == State::INSTANTIATED || r_volume.state == State::ATTACHED) {
+        ResourceManager::Unreference<Scene>(r_volume.path);
+    }
+    r_volume.scene = {};
+    r_volume.state = State::UNLOADED;
+}
+
+bool WorldStreamer::Instantiate(StreamedScene& r_volume, std::chrono::steady_clock::time_point p_deadline) {
+    Scene& scene = *r_volume.scene.Get();
+    if (!r_volume.instancer.has_value()) {
+        if (scene.GetBaked() == nullptr) {
+            r_volume.instance = scene.Instantiate();
+            return true;
+        }
+        r_volume.instancer.emplace(*scene.GetBaked());
+    }
+    while (!r_volume.instancer->Step(NODE_BATCH_SIZE)) {
+        if (std::chrono::steady_clock::now() >= p_deadline) {
+            return false;
+        }
+    }
+    r_volume.instance = r_volume.instancer->GetRoot();
+    r_volume.instancer.reset();
+    return true;
+}
+
+void WorldStreamer::DestroyReleased(std::chrono::steady_clock::time_point p_deadline) {
+    // Children are detached and destroyed on their own, so no single node
+    // takes a whole subtree down with it
+    do {
+        for (uint i = 0; i < NODE_BATCH_SIZE && !released.empty(); ++i) {
+            Ref<Node> node = std::move(released.back());
+            released.pop_back();
+            for (const auto& child : node->children) {
+                child->active = false;
+                released.push_back(child);
+            }
+            node->RemoveChildren();
+        }
+    } while (!released.empty() && std::chrono::steady_clock::now() < p_deadline);
+}
+
+void WorldStreamer::Update(Vec3 p_viewer) {
+    using State = StreamedScene::State;
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + frame_budget;
+
+    // Starting and cancelling loads is cheap and happens right away, the
+    // remaining steps are collected and run within the frame budget
+    steps.clear();
+    stats = Stats{};
+    for (StreamedScene* volume : volumes) {
+        if (volume->node == nullptr || IsReleased(*volume->node)) {
+            continue;
+        }
+        const float distance = GetDistance(*volume, p_viewer);
+        const bool near = distance <= volume->radius;
+        const bool far = distance > volume->radius * (1.0f + hysteresis);
+
+        switch (volume->state) {
+            case State::UNLOADED: {
+                if (near) {
+                    volume->scene = ResourceManager::LoadAsync<Scene>(volume->path);
+                    volume->state = State::LOADING;
+                    stats.loading++;
+                }
+            } break;
+            case State::LOADING: {
+                if (far) {
+                    Release(*volume);
+                } else if (!volume->scene.IsReady()) {
+                    stats.loading++;
+                } else if (volume->scene.Get() == nullptr) {
+                    std::println("Could not stream in {}", volume->path);
+                    volume->state = State::FAILED;
+                } else {
+                    steps.push_back(Step{distance, volume, volume->state, false});
+                    stats.loading++;
+                }
+            } break;
+            case State::INSTANTIATING: {
+                steps.push_back(Step{distance, volume, volume->state, far});
+                stats.loading++;
+            } break;
+            case State::INSTANTIATED: {
+                if (far || IsLoaded(*volume->instance)) {
+                    steps.push_back(Step{distance, volume, volume->state, far});
+                }
+                stats.instantiated++;
+            } break;
+            case State::ATTACHED: {
+                if (far) {
+                    steps.push_back(Step{distance, volume, volume->state, true});
+                }
+                stats.attached++;
+            } break;
+            case State::FAILED:
+                break;
+        }
+    }
+
+    std::ranges::sort(steps, {}, &Step::distance);
+    for (const Step& step : steps) {
+        if (stats.steps > 0 && std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+        // Volumes may have been unregistered or changed state since
+        if (std::ranges::find(volumes, step.volume) == volumes.end() || step.volume->state != step.state) {
+            continue;
+        }
+        StreamedScene& volume = *step.volume;
+        if (step.release) {
+            Release(volume);
+        } else if (volume.state == State::LOADING || volume.state == State::INSTANTIATING) {
+            volume.state = Instantiate(volume, deadline) ? State::INSTANTIATED : State::INSTANTIATING;
+        } else {
+            volume.node->AddChild(volume.instance);
+            volume.state = State::ATTACHED;
+        }
+        stats.steps++;
+    }
+
+    if (!released.empty()) {
+        DestroyReleased(deadline);
+    }
+    stats.releasing = released.size();
+    stats.time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <gauge/common.hpp>
+#include <gauge/components/streamed_scene.hpp>
+#include <gauge/math/common.hpp>
+
+#include <chrono>
+#include <vector>
+
+namespace Gauge {
+
+class Node;
+
+// Streams the subscenes of StreamedScene components in and out by the
+// distance between the viewer and their bounds. A scene starts loading as a
+// job once the viewer is within its radius and is unloaded again beyond
+// radius * (1 + hysteresis), so moving along the edge doesn't thrash.
+// Loaded scenes are instantiated off the tree and attached once all their
+// components finished loading their resources.
+//
+// Instantiating, attaching and detaching happen in Update, closest scenes
+// first, and stop for the frame once the frame budget is used up. At least
+// one such step runs per frame so streaming always makes progress. Scenes
+// are instantiated and released instances destroyed a batch of nodes at a
+// time, so a large subscene is spread over several frames.
+class WorldStreamer {
+   public:
+    struct Stats {
+        uint loading = 0;
+        uint instantiated = 0;
+        uint attached = 0;
+        // Nodes of released instances waiting to be destroyed
+        uint releasing = 0;
+        // Streaming steps run by the last Update and the time they took
+        uint steps = 0;
+        std::chrono::microseconds time{};
+    };
+
+   private:
+    static constexpr uint NODE_BATCH_SIZE = 64;
+
+    struct Step {
+        float distance;
+        StreamedScene* volume;
+        StreamedScene::State state;
+        bool release;
+    };
+
+    std::vector<StreamedScene*> volumes;
+    // Collected by Update, kept between frames so collecting does not allocate
+    std::vector<Step> steps;
+    // Detached subtrees of released instances, destroyed in Update
+    std::vector<Ref<Node>> released;
+    std::chrono::microseconds frame_budget{1000};
+    float hysteresis = 0.25f;
+    Stats stats;
+
+    static float GetDistance(const StreamedScene& p_volume, Vec3 p_viewer);
+    static bool IsLoaded(const Node& p_node);
+    // Released subtrees are deactivated at their root until destroyed
+    static bool IsReleased(const Node& p_node);
+    void Release(StreamedScene& r_volume);
+    // Returns true once the instance is complete
+    bool Instantiate(StreamedScene& r_volume, std::chrono::steady_clock::time_point p_deadline);
+    void DestroyReleased(std::chrono::steady_clock::time_point p_deadline);
+
+   public:
+    void Register(StreamedScene* p_volume);
+    void Unregister(StreamedScene* p_volume);
+
+    // Called once per frame on the render thread after uploads were
+    // processed, outside of the update phase
+    void Update(Vec3 p_viewer);
+
+    void SetFrameBudget(std::chrono::microseconds p_budget) { frame_budget = p_budget; }
+    void SetHysteresis(float p_hysteresis) { hysteresis = p_hysteresis; }
+    const Stats& GetStats() const { return stats; }
+
+    static WorldStreamer& Get();
+};
+
+}  // namespace Gauge
@@ -0,0 +1,88 @@
+// Bakes component parameters and reads them back through PropertyBlob, the
+// way components without a binary constructor see them.
+
+#include <gauge/scene/baked_scene.hpp>
+#include <gauge/scene/property_blob.hpp>
+#include <gauge/scene/scene_baker.hpp>
+
+#include <gtest/gtest.h>
+#include <yaml-cpp/yaml.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace Gauge;
+
+namespace {
+
+// Bakes a scene with a single component and returns its parameters
+std::vector<char> BakeComponent(const std::string& p_component) {
+    SceneBaker baker;
+    const YAML::Node scene = YAML::Load("components: [" + p_component + "]");
+    auto baked = baker.Bake(scene);
+    EXPECT_TRUE(baked.has_value());
+    const std::vector<char> output = baker.Finish();
+
+    BakedScene::Header header;
+    std::memcpy(&header, output.data(), sizeof(header));
+    EXPECT_EQ(header.component_count, 1u);
+    BakedScene::ComponentEntry entry;
+    std::memcpy(&entry, output.data() + header.components_offset, sizeof(entry));
+    EXPECT_EQ(entry.encoding, BakedScene::Encoding::PROPERTIES);
+
+    const char* parameters = output.data() + header.data_offset + entry.offset;
+    return std::vector<char>(parameters, parameters + entry.size);
+}
+
+}  // namespace
+
+TEST(SceneBaker, OnlyYAMLBooleansAreBools) {
+    const std::vector<char> data = BakeComponent(
+        "{type: test, a: true, b: False, c: TRUE, d: y, e: n, f: yes, g: no, h: on, i: off, j: Yes, k: 'true'}");
+    auto blob = PropertyBlob::FromData(data);
+    ASSERT_TRUE(blob.has_value());
+
+    for (const char* key : {"a", "b", "c"}) {
+        ASSERT_NE(blob->Find(key), nullptr) << key;
+        EXPECT_EQ(blob->Find(key)->type, PropertyBlob::Type::BOOL) << key;
+    }
+    for (const char* key : {"d", "e", "f", "g", "h", "i", "j", "k"}) {
+        ASSERT_NE(blob->Find(key), nullptr) << key;
+        EXPECT_EQ(blob->Find(key)->type, PropertyBlob::Type::STRING) << key;
+    }
+    EXPECT_TRUE(blob->Get<bool>("a", false));
+    EXPECT_FALSE(blob->Get<bool>("b", true));
+    EXPECT_TRUE(blob->Get<bool>("c", false));
+}
+
+// Scalars read back from the blob must match what the YAML constructor of
+// the component would have seen
+TEST(SceneBaker, ScalarsRoundTripThroughToYAML) {
+    const YAML::Node source = YAML::Load(
+        "{type: test, a: true, b: false, d: y, e: n, f: yes, g: no, h: on, i: off, "
+        "j: Yes, k: 'true', count: -3, ratio: 0.5, name: lamp, scale: [1, 2, 3]}");
+    std::string component;
+    {
+        YAML::Emitter emitter;
+        emitter << YAML::Flow << source;
+        component = emitter.c_str();
+    }
+    const std::vector<char> data = BakeComponent(component);
+    auto blob = PropertyBlob::FromData(data);
+    ASSERT_TRUE(blob.has_value());
+    const YAML::Node result = blob->ToYAML();
+
+    for (const char* key : {"d", "e", "f", "g", "h", "i", "j", "k", "name"}) {
+        ASSERT_TRUE(result[key].IsScalar()) << key;
+        EXPECT_EQ(result[key].as<std::string>(), source[key].as<std::string>()) << key;
+    }
+    for (const char* key : {"a", "b", "d", "e", "f", "g", "h", "i", "j"}) {
+        EXPECT_EQ(result[key].as<bool>(), source[key].as<bool>()) << key;
+    }
+    EXPECT_EQ(result["count"].as<int64_t>(), -3);
+    EXPECT_FLOAT_EQ(result["ratio"].as<float>(), 0.5f);
+    ASSERT_TRUE(result["scale"].IsSequence());
+    ASSERT_EQ(result["scale"].size(), 3u);
+    EXPECT_FLOAT_EQ(result["scale"][2].as<float>(), 3.0f);
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+// Interns and resolves StringIDs from many threads at once. Meant to be run
+// under ThreadSanitizer as well, configure with -DGAUGE_SANITIZER=thread.
+
+#include <gauge/core/string_id.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <format>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Gauge;
+
+namespace {
+
+constexpr uint SHARED_NAME_COUNT = 2000;
+constexpr uint UNIQUE_NAME_COUNT = 2000;
+
+uint GetThreadCount() {
+    return std::max(4u, std::thread::hardware_concurrency());
+}
+
+}  // namespace
+
+// Every thread interns the same names, racing on the same entries, and its
+// own names, racing on the shards, while reading back what the others wrote
+TEST(StringID, ConcurrentInterning) {
+    const uint thread_count = GetThreadCount();
+    std::vector<std::string> shared_names;
+    for (uint i = 0; i < SHARED_NAME_COUNT; ++i) {
+        shared_names.push_back(std::format("stress/shared/{}", i));
+    }
+
+    std::barrier start(thread_count);
+    std::atomic<uint> failures = 0;
+    std::vector<std::thread> threads;
+    for (uint thread = 0; thread < thread_count; ++thread) {
+        threads.emplace_back([&, thread]() {
+            start.arrive_and_wait();
+            for (uint i = 0; i < UNIQUE_NAME_COUNT; ++i) {
+                // Walk the shared names in a different order on every thread
+                const std::string& shared_name = shared_names[(i * (thread + 1)) % SHARED_NAME_COUNT];
+                const StringID shared_id(shared_name);
+                if (shared_id.GetString() != shared_name) {
+                    failures++;
+                }
+
+                const std::string unique_name = std::format("stress/thread{}/{}", thread, i);
+                const StringID unique_id(unique_name);
+                if (unique_id.GetString() != unique_name) {
+                    failures++;
+                }
+
+                // Written by another thread, possibly not yet
+                const std::string other_name = std::format("stress/thread{}/{}", (thread + 1) % thread_count, i);
+                const std::string* other = StringID::Lookup(StringID::Hash(other_name));
+                if (other != nullptr && *other != other_name) {
+                    failures++;
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(failures, 0u);
+    for (uint thread = 0; thread < thread_count; ++thread) {
+        for (uint i = 0; i < UNIQUE_NAME_COUNT; i += 97) {
+            const std::string name = std::format("stress/thread{}/{}", thread, i);
+            EXPECT_EQ(StringID::FromHash(StringID::Hash(name)).GetString(), name);
+        }
+    }
+}
+
+// Strings returned by GetString are referenced without holding a lock, they
+// must survive other threads growing the same shards
+TEST(StringID, ReferencesStayValid) {
+    const uint thread_count = GetThreadCount();
+    std::vector<const std::string*> strings;
+    for (uint i = 0; i < 256; ++i) {
+        strings.push_back(&StringID(std::format("stable/{}", i)).GetString());
+    }
+
+    std::barrier start(thread_count + 1);
+    std::vector<std::thread> threads;
+    for (uint thread = 0; thread < thread_count; ++thread) {
+        threads.emplace_back([&, thread]() {
+            start.arrive_and_wait();
+            for (uint i = 0; i < 5000; ++i) {
+                StringID(std::format("growth/thread{}/{}", thread, i));
+            }
+        });
+    }
+    start.arrive_and_wait();
+    uint mismatches = 0;
+    for (uint round = 0; round < 20; ++round) {
+        for (uint i = 0; i < strings.size(); ++i) {
+            if (*strings[i] != std::format("stable/{}", i)) {
+                mismatches++;
+            }
+        }
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(mismatches, 0u);
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+// Bakes a YAML scene into the binary format read by BakedScene.
+//
+// Usage: gauge_bake_scene <input.yaml> <output>
+//
+// The baked file can replace the YAML file under its original path, Scene::Load
+// detects the format. Component parameters that are scalars or numeric lists
+// become PropertyBlobs; components with nested parameters are kept as YAML.
+
+#include <gauge/core/filesystem.hpp>
+#include <gauge/scene/scene_baker.hpp>
+
+#include <yaml-cpp/yaml.h>
+
+#include <fstream>
+#include <print>
+#include <string>
+#include <vector>
+
+using namespace Gauge;
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::println("Usage: {} <input.yaml> <output>", argv[0]);
+        return 1;
+    }
+
+    auto source = FileSystem::ReadFile(argv[1]);
+    if (!source) {
+        std::println("Error: Could not read {}: {}", argv[1], source.error());
+        return 1;
+    }
+
+    YAML::Node root;
+    try {
+        root = YAML::Load(std::string(source->data(), source->size()));
+    } catch (const YAML::Exception& exception) {
+        std::println("Error: Could not parse {}: {}", argv[1], exception.what());
+        return 1;
+    }
+
+    SceneBaker baker;
+    auto result = baker.Bake(root);
+    if (!result) {
+        std::println("Error: {}", result.error());
+        return 1;
+    }
+    const std::vector<char> baked = baker.Finish();
+
+    std::ofstream output(argv[2], std::ios::binary | std::ios::trunc);
+    output.write(baked.data(), baked.size());
+    if (!output.good()) {
+        std::println("Error: Could not write {}", argv[2]);
+        return 1;
+    }
+    std::println("Baked {} nodes and {} components into {} bytes", baker.GetNodeCount(), baker.GetComponentCount(), baked.size());
+    return 0;
+}
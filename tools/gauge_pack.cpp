@@ -0,0 +1,192 @@
+// Builds an asset pack from a directory tree.
+//
+// Usage: gauge_pack <output> <root> [directory...]
+//
+// Every file below the given directories (or below root if none are given) is
+// stored under its path relative to root, which is how the engine refers to it,
+// e.g. "assets/textures/lightbulb.png" or "shaders/pbr.spv".
+
+#include <gauge/core/asset_pack.hpp>
+#include <gauge/core/compression.hpp>
+#include <gauge/core/filesystem.hpp>
+#include <gauge/core/string_id.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <print>
+#include <string>
+#include <vector>
+
+using namespace Gauge;
+
+namespace {
+
+// Compressed data is only kept if it saves at least this fraction of the size
+constexpr float MIN_COMPRESSION_GAIN = 0.1f;
+constexpr size_t MIN_COMPRESSION_SIZE = 1024;
+
+struct SourceFile {
+    std::filesystem::path path;
+    std::string key;
+    uint64_t id;
+};
+
+void WritePadding(std::ofstream& r_output) {
+    static constexpr char zeros[AssetPack::ALIGNMENT]{};
+    const size_t position = r_output.tellp();
+    const size_t padding = (AssetPack::ALIGNMENT - position % AssetPack::ALIGNMENT) % AssetPack::ALIGNMENT;
+    r_output.write(zeros, padding);
+}
+
+Result<std::vector<SourceFile>> CollectFiles(const std::filesystem::path& p_root, const std::vector<std::filesystem::path>& p_directories) {
+    std::vector<SourceFile> files;
+    for (const auto& directory : p_directories) {
+        std::error_code error;
+        for (const auto& item : std::filesystem::recursive_directory_iterator(p_root / directory, error)) {
+            if (!item.is_regular_file()) {
+                continue;
+            }
+            const std::string key = AssetPack::NormalizePath(std::filesystem::relative(item.path(), p_root).generic_string());
+            files.push_back(SourceFile{
+                .path = item.path(),
+                .key = key,
+                .id = StringID::Hash(key),
+            });
+        }
+        if (error) {
+            return Error(std::format("Could not read directory {}: {}", (p_root / directory).string(), error.message()));
+        }
+    }
+
+    std::ranges::sort(files, {}, &SourceFile::id);
+    for (size_t i = 1; i < files.size(); ++i) {
+        if (files[i].id == files[i - 1].id) {
+            if (files[i].key == files[i - 1].key) {
+                return Error(std::format("{} was added twice", files[i].key));
+            }
+            return Error(std::format("Hash collision between {} and {}", files[i].key, files[i - 1].key));
+        }
+    }
+    return files;
+}
+
+Result<> WritePack(const std::filesystem::path& p_output, const std::vector<SourceFile>& p_files) {
+    std::ofstream output(p_output, std::ios::binary | std::ios::trunc);
+    if (!output.is_open()) {
+        return Error(std::format("Could not open {} for writing", p_output.string()));
+    }
+
+    AssetPack::Header header{};
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<AssetPack::Entry> entries;
+    std::vector<AssetPack::Chunk> chunks;
+    entries.reserve(p_files.size());
+    size_t total_size = 0;
+
+    for (const SourceFile& source : p_files) {
+        auto data = FileSystem::ReadFile(source.path.string());
+        if (!data) {
+            return Error(std::format("Could not read {}: {}", source.path.string(), data.error()));
+        }
+        const std::vector<char>& bytes = data.value();
+        total_size += bytes.size();
+
+        AssetPack::Entry entry{
+            .id = source.id,
+            .size = bytes.size(),
+            .compression = AssetPack::Compression::NONE,
+        };
+
+        // Compress chunk by chunk and keep the result only if it pays off
+        std::vector<AssetPack::Chunk> file_chunks;
+        std::vector<std::vector<char>> compressed_chunks;
+        size_t compressed_size = 0;
+        if (bytes.size() >= MIN_COMPRESSION_SIZE) {
+            for (size_t offset = 0; offset < bytes.size(); offset += AssetPack::CHUNK_SIZE) {
+                const size_t chunk_size = std::min<size_t>(AssetPack::CHUNK_SIZE, bytes.size() - offset);
+                std::vector<char> compressed(Compression::CompressBoundLZ4(chunk_size));
+                compressed.resize(Compression::CompressLZ4({bytes.data() + offset, chunk_size}, compressed));
+                if (compressed.size() >= chunk_size) {
+                    compressed.assign(bytes.begin() + offset, bytes.begin() + offset + chunk_size);
+                }
+                file_chunks.push_back(AssetPack::Chunk{
+                    .compressed_size = uint32_t(compressed.size()),
+                    .size = uint32_t(chunk_size),
+                });
+                compressed_size += compressed.size();
+                compressed_chunks.emplace_back(std::move(compressed));
+            }
+        }
+
+        WritePadding(output);
+        entry.offset = output.tellp();
+        if (!file_chunks.empty() && compressed_size <= bytes.size() * (1.0f - MIN_COMPRESSION_GAIN)) {
+            entry.compression = AssetPack::Compression::LZ4;
+            entry.first_chunk = chunks.size();
+            entry.chunk_count = file_chunks.size();
+            for (size_t i = 0; i < file_chunks.size(); ++i) {
+                file_chunks[i].offset = output.tellp();
+                output.write(compressed_chunks[i].data(), compressed_chunks[i].size());
+                chunks.push_back(file_chunks[i]);
+            }
+        } else {
+            output.write(bytes.data(), bytes.size());
+        }
+
+        std::println("{} ({} -> {} bytes)", source.key, bytes.size(), size_t(output.tellp()) - entry.offset);
+        entries.push_back(entry);
+    }
+
+    WritePadding(output);
+    header.chunk_table_offset = output.tellp();
+    output.write(reinterpret_cast<const char*>(chunks.data()), chunks.size() * sizeof(AssetPack::Chunk));
+
+    WritePadding(output);
+    header.index_offset = output.tellp();
+    output.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(AssetPack::Entry));
+    const size_t pack_size = output.tellp();
+
+    std::memcpy(header.magic, AssetPack::MAGIC, sizeof(header.magic));
+    header.version = AssetPack::VERSION;
+    header.entry_count = entries.size();
+    header.chunk_count = chunks.size();
+    output.seekp(0);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    if (!output.good()) {
+        return Error(std::format("Could not write {}", p_output.string()));
+    }
+    std::println("Packed {} files, {} -> {} bytes", entries.size(), total_size, pack_size);
+    return {};
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::println("Usage: {} <output> <root> [directory...]", argv[0]);
+        return 1;
+    }
+
+    const std::filesystem::path output(argv[1]);
+    const std::filesystem::path root(argv[2]);
+    std::vector<std::filesystem::path> directories;
+    for (int i = 3; i < argc; ++i) {
+        directories.emplace_back(argv[i]);
+    }
+    if (directories.empty()) {
+        directories.emplace_back(".");
+    }
+
+    auto result = CollectFiles(root, directories).and_then([&output](const std::vector<SourceFile>& p_files) {
+        return WritePack(output, p_files);
+    });
+    if (!result) {
+        std::println("Error: {}", result.error());
+        return 1;
+    }
+    return 0;
+}